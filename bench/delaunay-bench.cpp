@@ -0,0 +1,321 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "delaunay-triangulation.h"
+
+// Benchmarks of triangulate() with every engine and of the query APIs, on
+// standard point distributions from 1e3 to 1e7 points. Run with
+//     delaunay-bench --benchmark_out=bench.json --benchmark_out_format=json
+// and compare two such files with compare.py from Google Benchmark to gate
+// on regressions. Use --benchmark_filter to pick a subset, e.g.
+// 'triangulate/sweep_hull/.*/1000000/'.
+
+namespace{
+
+// Heap bytes in use and their peak, kept by the global operator new and
+// delete below. Unlike the peak resident set size of the process, the peak
+// can be reset before each benchmark, so it does not depend on what ran
+// before.
+std::atomic<size_t> heap_bytes{0};
+std::atomic<size_t> heap_peak{0};
+
+void* counted(void* p)
+{
+    if(p == nullptr){
+        throw std::bad_alloc();
+    }
+    const size_t n = malloc_usable_size(p);
+    const size_t now = heap_bytes.fetch_add(n, std::memory_order_relaxed) + n;
+    size_t peak = heap_peak.load(std::memory_order_relaxed);
+    while(now > peak && !heap_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)){}
+    return p;
+}
+
+void uncounted(void* p)
+{
+    if(p != nullptr){
+        heap_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+        std::free(p);
+    }
+}
+
+}
+
+// The other forms of new and delete forward to these
+void* operator new(const size_t n)
+{
+    return counted(std::malloc(n == 0 ? 1 : n));
+}
+
+void* operator new(const size_t n, const std::align_val_t alignment)
+{
+    const auto a = static_cast<size_t>(alignment);
+    return counted(std::aligned_alloc(a, (n + a - 1)/a*a));
+}
+
+void operator delete(void* p) noexcept
+{
+    uncounted(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    uncounted(p);
+}
+
+// The sized forms, which the library would forward to the unsized ones
+// anyway, replaced along with them as -Wsized-deallocation asks
+void operator delete(void* p, size_t) noexcept
+{
+    uncounted(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    uncounted(p);
+}
+
+namespace{
+
+using Float = double;
+using Int = uint32_t;
+
+enum class PointSet{
+    uniform,
+    clustered,
+    grid,
+    circle,
+    survey
+};
+
+constexpr std::array<std::pair<PointSet, const char*>, 5> distributions{{
+    {PointSet::uniform, "uniform"},
+    {PointSet::clustered, "clustered"},
+    {PointSet::grid, "grid"},
+    {PointSet::circle, "circle"},
+    {PointSet::survey, "survey"}
+}};
+
+constexpr std::array<std::pair<Engine, const char*>, 3> engines{{
+    {Engine::incremental, "incremental"},
+    {Engine::divide_and_conquer, "divide_and_conquer"},
+    {Engine::sweep_hull, "sweep_hull"}
+}};
+
+std::vector<Vertex<Float>> make_points(const PointSet distribution, const size_t n)
+{
+    std::mt19937_64 rng(n);
+    std::uniform_real_distribution<Float> unit(0, 1);
+    std::vector<Vertex<Float>> res;
+    res.reserve(n);
+    switch(distribution){
+    case PointSet::uniform:
+        while(res.size() < n){
+            res.push_back({unit(rng), unit(rng)});
+        }
+        break;
+    case PointSet::clustered:{
+        // Gaussian blobs of a thousand points each on average
+        std::vector<Vertex<Float>> centers(std::max<size_t>(n/1000, 1));
+        for(auto& c : centers){
+            c = {unit(rng), unit(rng)};
+        }
+        std::uniform_int_distribution<size_t> pick(0, centers.size() - 1);
+        std::normal_distribution<Float> spread(0, 0.01);
+        while(res.size() < n){
+            const auto& c = centers[pick(rng)];
+            res.push_back({c.x() + spread(rng), c.y() + spread(rng)});
+        }
+        break;
+    }
+    case PointSet::grid:{
+        // Every unit square has four cocircular corners
+        const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+        for(size_t i = 0; res.size() < n; i++){
+            res.push_back({static_cast<Float>(i % side), static_cast<Float>(i/side)});
+        }
+        break;
+    }
+    case PointSet::circle:
+        // Every point on the hull, and all of them nearly cocircular
+        while(res.size() < n){
+            const Float a = 2*std::numbers::pi_v<Float>*unit(rng);
+            res.push_back({std::cos(a), std::sin(a)});
+        }
+        break;
+    case PointSet::survey:{
+        // Like an airborne laser scan of a 1 km tile: jittered scan lines,
+        // far denser along a line than across, in swaths of varying
+        // density, with coordinates stored to the centimeter
+        const Float spacing = 1000/std::sqrt(static_cast<Float>(n)/8);
+        std::normal_distribution<Float> jitter(0, spacing/20);
+        std::uniform_real_distribution<Float> density(0.5, 1.5);
+        auto centimeters = [](const Float v) {return std::round(100*v)/100;};
+        Float y = 0, step = spacing/8*density(rng);
+        for(size_t i = 0; res.size() < n; i++){
+            const Float x = std::fmod(static_cast<Float>(i)*step, 1000);
+            if(i > 0 && x < std::fmod(static_cast<Float>(i - 1)*step, 1000)){
+                y = std::fmod(y + spacing, 1000);
+                if(y < spacing){
+                    step = spacing/8*density(rng);
+                }
+            }
+            res.push_back({centimeters(x + jitter(rng)), centimeters(y + jitter(rng))});
+        }
+        break;
+    }
+    }
+    return res;
+}
+
+// Query points next to randomly chosen input points
+std::vector<Vertex<Float>> make_queries(const std::vector<Vertex<Float>>& points, const size_t n)
+{
+    std::mt19937_64 rng(n + points.size());
+    std::uniform_int_distribution<size_t> pick(0, points.size() - 1);
+    auto [xmin, xmax] = std::ranges::minmax(points, {}, [](const Vertex<Float>& p) {return p.x();});
+    Float scale = (xmax.x() - xmin.x())/std::sqrt(static_cast<Float>(points.size()));
+    std::normal_distribution<Float> jitter(0, scale);
+    std::vector<Vertex<Float>> res(n);
+    for(auto& q : res){
+        const auto& p = points[pick(rng)];
+        q = {p.x() + jitter(rng), p.y() + jitter(rng)};
+    }
+    return res;
+}
+
+void reset_peak_heap()
+{
+    heap_peak.store(heap_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+// Peak heap use since reset_peak_heap() above what was in use then, in MiB
+double peak_heap_mib(const size_t baseline)
+{
+    return static_cast<double>(heap_peak.load(std::memory_order_relaxed) - baseline)/(1 << 20);
+}
+
+void triangulate(benchmark::State& state, const PointSet distribution, const Engine engine)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto points = make_points(distribution, n);
+    const size_t baseline = heap_bytes.load();
+    reset_peak_heap();
+    for(auto _ : state){
+        Delaunay<Float, Int> d;
+        // In the given order each walk crosses O(sqrt(n)) triangles, which
+        // does not scale to the larger sizes
+        d.insertion_order(InsertionOrder::brio);
+        d.triangulate(points, engine);
+        benchmark::DoNotOptimize(d.triangles_view().data());
+        benchmark::ClobberMemory();
+    }
+    const auto processed = state.iterations()*static_cast<int64_t>(n);
+    state.SetItemsProcessed(processed);
+    state.counters["points_per_second"] = benchmark::Counter(static_cast<double>(processed), benchmark::Counter::kIsRate);
+    state.counters["peak_heap_mib"] = peak_heap_mib(baseline);
+
+    // Counts from one instrumented run, outside the timed loop
+    Delaunay<Float, Int, Instrumentation> d;
+    d.insertion_order(InsertionOrder::brio);
+    d.triangulate(points, engine);
+    const auto& stats = d.instrumentation().stats();
+    auto per_point = [n](const uint64_t count) {return static_cast<double>(count)/static_cast<double>(n);};
+    state.counters["orientation_tests_per_point"] = per_point(stats[Counter::orientation_tests]);
+    state.counters["incircle_tests_per_point"] = per_point(stats[Counter::incircle_tests]);
+    state.counters["flips_per_point"] = per_point(stats[Counter::flips]);
+    state.counters["walk_steps_per_point"] = per_point(stats[Counter::walk_steps]);
+    state.counters["triangles"] = static_cast<double>(d.triangles_view().size());
+}
+
+// Sets up a batch query on a triangulation, given the number of query
+// points, and returns the call that is timed. Buffers the query reads are
+// made here rather than in every timed call.
+using Query = std::function<std::function<void(std::span<const Vertex<Float>>)>(const Delaunay<Float, Int>&, size_t)>;
+
+// A batch query on a triangulation of the distribution, run over a
+// hundred thousand query points at a time. The peak heap use includes the
+// triangulation.
+void query(benchmark::State& state, const PointSet distribution, const Query& prepare)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto points = make_points(distribution, n);
+    const auto queries = make_queries(points, 100000);
+    const size_t baseline = heap_bytes.load();
+    reset_peak_heap();
+    Delaunay<Float, Int> d;
+    d.triangulate(points, Engine::sweep_hull);
+    const auto run = prepare(d, queries.size());
+    for(auto _ : state){
+        run(queries);
+        benchmark::ClobberMemory();
+    }
+    const auto processed = state.iterations()*static_cast<int64_t>(queries.size());
+    state.SetItemsProcessed(processed);
+    state.counters["queries_per_second"] = benchmark::Counter(static_cast<double>(processed), benchmark::Counter::kIsRate);
+    state.counters["peak_heap_mib"] = peak_heap_mib(baseline);
+}
+
+void register_benchmarks()
+{
+    for(const auto& [distribution, distribution_name] : distributions){
+        for(const auto& [engine, engine_name] : engines){
+            benchmark::RegisterBenchmark((std::string("triangulate/") + engine_name + "/" + distribution_name).c_str(),
+                triangulate, distribution, engine)
+                ->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+        }
+    }
+    const std::array<std::pair<const char*, Query>, 4> queries{{
+        {"locate", [](const Delaunay<Float, Int>& d, size_t)
+            {
+                return [&d](std::span<const Vertex<Float>> q) {benchmark::DoNotOptimize(d.locate(q).data());};
+            }},
+        {"nearest_vertex", [](const Delaunay<Float, Int>& d, size_t)
+            {
+                return [&d](std::span<const Vertex<Float>> q) {benchmark::DoNotOptimize(d.nearest_vertex(q).data());};
+            }},
+        {"k_nearest", [](const Delaunay<Float, Int>& d, size_t)
+            {
+                return [&d](std::span<const Vertex<Float>> q) {benchmark::DoNotOptimize(d.k_nearest(q, 8).data());};
+            }},
+        {"interpolate", [](const Delaunay<Float, Int>& d, const size_t n)
+            {
+                auto values = std::make_shared<std::vector<double>>(d.coordinates(0).size(), 1.);
+                auto out = std::make_shared<std::vector<double>>(n);
+                return [&d, values, out](std::span<const Vertex<Float>> q)
+                    {
+                        d.interpolate<double>(*values, 1, q, *out);
+                        benchmark::DoNotOptimize(out->data());
+                    };
+            }}
+    }};
+    for(const auto& [distribution, distribution_name] : distributions){
+        for(const auto& [query_name, prepare] : queries){
+            benchmark::RegisterBenchmark((std::string(query_name) + "/" + distribution_name).c_str(),
+                query, distribution, prepare)
+                ->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)){
+        return 1;
+    }
+    register_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,621 @@
+// Snapshots of a triangulation and the read-only DelaunayView over them.
+// Delaunay builds on the view, so this header is part of
+// delaunay-triangulation.h and included from it where the view is needed.
+#include "delaunay-triangulation.h"
+
+#ifndef DELAUNAY_SNAPSHOT_LIB_H
+#define DELAUNAY_SNAPSHOT_LIB_H
+
+#include <system_error>
+#include <cerrno>
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Header of a triangulation snapshot, written by Delaunay::save() and read
+// in place by DelaunayView. Snapshots are little-endian. The header is
+// followed by four sections, each starting on a 64 byte boundary and padded
+// with zeros up to the next one: the x and the y coordinates of the vertices,
+// the triangle slots as three vertex indices and then three neighbor indices
+// each, finite triangles first and absent neighbors stored as the largest
+// index, and a triangle around each vertex. The checksum, present if flags
+// has has_checksum set, covers everything after the header.
+struct SnapshotHeader{
+    static constexpr std::array<char, 8> signature{'D', 'E', 'L', 'A', 'U', 'N', 'A', 'Y'};
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t has_checksum = 1;
+    static constexpr size_t alignment = 64;
+
+    std::array<char, 8> magic = signature;
+    uint32_t version = current_version;
+    uint32_t flags = 0;
+    // Bytes per coordinate and per index, and whether coordinates are
+    // floating point
+    uint32_t float_size = 0;
+    uint32_t float_floating = 0;
+    uint32_t int_size = 0;
+    uint32_t reserved = 0;
+    uint64_t vertices = 0;
+    uint64_t triangles = 0;
+    uint64_t finite = 0;
+    uint64_t x_offset = 0;
+    uint64_t y_offset = 0;
+    uint64_t triangles_offset = 0;
+    uint64_t vertex_triangles_offset = 0;
+    // Bytes in the whole snapshot
+    uint64_t size = 0;
+    uint64_t checksum = 0;
+    std::array<uint64_t, 3> padding{};
+};
+static_assert(sizeof(SnapshotHeader) == 128 && std::is_trivially_copyable_v<SnapshotHeader>);
+
+// Checksum of snapshots: the xxHash64 round folded over the data as 64 bit
+// words, a last partial word padded with zeros, and the xxHash64 avalanche
+class SnapshotChecksum{
+private:
+    static constexpr uint64_t prime1 = 0x9e3779b185ebca87, prime2 = 0xc2b2ae3d27d4eb4f;
+    static constexpr uint64_t prime3 = 0x165667b19e3779f9, prime4 = 0x85ebca77c2b2ae63;
+    uint64_t hash_m = 0x27d4eb2f165667c5;
+    std::array<std::byte, 8> tail_m{};
+    size_t tail_size_m = 0;
+
+    static uint64_t mix(uint64_t h, const std::byte* word)
+    {
+        uint64_t w;
+        std::memcpy(&w, word, sizeof(w));
+        h ^= std::rotl(w*prime2, 31)*prime1;
+        return std::rotl(h, 27)*prime1 + prime4;
+    }
+public:
+    void update(std::span<const std::byte> data)
+    {
+        size_t i = 0;
+        while(tail_size_m > 0 && i < data.size()){
+            tail_m[tail_size_m++] = data[i++];
+            if(tail_size_m == tail_m.size()){
+                hash_m = mix(hash_m, tail_m.data());
+                tail_size_m = 0;
+            }
+        }
+        for(; i + 8 <= data.size(); i += 8){
+            hash_m = mix(hash_m, data.data() + i);
+        }
+        for(; i < data.size(); i++){
+            tail_m[tail_size_m++] = data[i];
+        }
+    }
+
+    uint64_t value() const
+    {
+        uint64_t h = hash_m;
+        if(tail_size_m > 0){
+            auto word = tail_m;
+            std::fill(std::begin(word) + tail_size_m, std::end(word), std::byte{0});
+            h = mix(h, word.data());
+        }
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        return h ^ (h >> 32);
+    }
+};
+
+inline uint64_t snapshot_checksum(std::span<const std::byte> data)
+{
+    SnapshotChecksum res;
+    res.update(data);
+    return res.value();
+}
+
+// Read-only triangulation over arrays it does not own: the vertex
+// coordinates, the triangle slots with the finite triangles first, as kept
+// by Delaunay, and optionally a triangle around each vertex, which the
+// adjacency queries need. Made by Delaunay::view() or over a snapshot,
+// which is used in place, e.g. straight from a memory-mapped file. The
+// arrays must outlive the view. Queries change nothing, so they may run on
+// several threads at once.
+template<Numeric Float, Integral Int>
+class DelaunayView{
+private:
+    std::array<std::span<const Float>, 2> coordinates_m;
+    std::span<const Triangle<Int>> triangles_m;
+    Int finite_m = 0;
+    std::span<const Int> vertex_triangles_m;
+
+    Float orientation(const Int a, const Int b, const Vertex<Float>& p) const
+    {
+        return orient2d<Float>(coordinates_m[0][a], coordinates_m[1][a], coordinates_m[0][b], coordinates_m[1][b], p.x(), p.y());
+    }
+
+    bool is_ghost(const Triangle<Int>& t) const
+    {
+        return std::ranges::find(t, infinite_vertex) != std::end(t);
+    }
+
+    // Call f(s, k) for the triangles s around vertex v in counterclockwise
+    // order, k being the local index of v in s. For a hull vertex the first
+    // is the one after the ghost triangle whose next corner is at infinity.
+    template<class Function>
+    void for_each_around(const Int v, Function&& f) const
+    {
+        auto t = vertex_triangle(v);
+        if(!t){
+            return;
+        }
+        Int first = *t;
+        Int s = first;
+        do{
+            const auto& ts = triangles_m[s];
+            Int k = std::ranges::find(ts, v) - std::begin(ts);
+            if(ts.vertices()[(k + 1) % 3] == infinite_vertex){
+                first = *ts.neighbors()[(k + 1) % 3];
+                break;
+            }
+            s = *ts.neighbors()[(k + 1) % 3];
+        }while(s != first);
+        s = first;
+        do{
+            const auto& ts = triangles_m[s];
+            Int k = std::ranges::find(ts, v) - std::begin(ts);
+            f(s, k);
+            s = *ts.neighbors()[(k + 1) % 3];
+        }while(s != first);
+    }
+public:
+    static constexpr Int infinite_vertex = std::numeric_limits<Int>::max();
+
+    DelaunayView() = default;
+    DelaunayView(std::span<const Float> x, std::span<const Float> y, std::span<const Triangle<Int>> triangles,
+                 const Int finite, std::span<const Int> vertex_triangles = {})
+     : coordinates_m{x, y}, triangles_m(triangles), finite_m(finite), vertex_triangles_m(vertex_triangles)
+    {}
+
+    // Over a snapshot, checking that it is complete and was written with the
+    // same coordinate and index types, and with verify set also checking its
+    // checksum, if it has one. The snapshot must start on a 64 byte boundary,
+    // as memory maps and buffers from load() do. The indices in it are only
+    // checked by validate().
+    explicit DelaunayView(std::span<const std::byte> snapshot, const bool verify = false)
+    {
+        static_assert(std::is_trivially_copyable_v<Triangle<Int>> && sizeof(Triangle<Int>) == 6*sizeof(Int));
+        const auto h = header(snapshot);
+        if(reinterpret_cast<uintptr_t>(snapshot.data()) % SnapshotHeader::alignment != 0){
+            throw std::invalid_argument("Snapshot does not start on a 64 byte boundary");
+        }
+        if(h.size > snapshot.size()){
+            throw std::length_error("Snapshot is truncated");
+        }
+        auto section = [&](const uint64_t offset, const uint64_t count, const size_t size)
+        {
+            if(offset % SnapshotHeader::alignment != 0 || offset < sizeof(SnapshotHeader) || offset > h.size || count > (h.size - offset)/size){
+                throw std::length_error("Snapshot section lies outside the snapshot");
+            }
+            return snapshot.data() + offset;
+        };
+        if(h.finite > h.triangles || h.triangles >= infinite_vertex || h.vertices >= infinite_vertex){
+            throw std::length_error("Snapshot has more triangles or vertices than the index type can number");
+        }
+        coordinates_m[0] = {reinterpret_cast<const Float*>(section(h.x_offset, h.vertices, sizeof(Float))), h.vertices};
+        coordinates_m[1] = {reinterpret_cast<const Float*>(section(h.y_offset, h.vertices, sizeof(Float))), h.vertices};
+        triangles_m = {reinterpret_cast<const Triangle<Int>*>(section(h.triangles_offset, h.triangles, sizeof(Triangle<Int>))), h.triangles};
+        vertex_triangles_m = {reinterpret_cast<const Int*>(section(h.vertex_triangles_offset, h.vertices, sizeof(Int))), h.vertices};
+        finite_m = static_cast<Int>(h.finite);
+        if(verify && (h.flags & SnapshotHeader::has_checksum) != 0
+                  && snapshot_checksum(snapshot.subspan(sizeof(SnapshotHeader), h.size - sizeof(SnapshotHeader))) != h.checksum){
+            throw std::invalid_argument("Snapshot checksum does not match its contents");
+        }
+    }
+
+    // The header of a snapshot, checked to be one written with these
+    // coordinate and index types on a little-endian machine
+    static SnapshotHeader header(std::span<const std::byte> snapshot)
+    {
+        if constexpr(std::endian::native != std::endian::little){
+            throw std::domain_error("Snapshots are little-endian and can only be used on little-endian machines");
+        }
+        SnapshotHeader res;
+        if(snapshot.size() < sizeof(res)){
+            throw std::length_error("Snapshot is shorter than its header");
+        }
+        std::memcpy(&res, snapshot.data(), sizeof(res));
+        if(res.magic != SnapshotHeader::signature){
+            throw std::invalid_argument("Not a triangulation snapshot");
+        }
+        if(res.version != SnapshotHeader::current_version){
+            throw std::domain_error("Unsupported snapshot version " + std::to_string(res.version));
+        }
+        if(res.float_size != sizeof(Float) || res.float_floating != std::is_floating_point_v<Float> || res.int_size != sizeof(Int)){
+            throw std::invalid_argument("Snapshot was written with different coordinate or index types");
+        }
+        if(res.size < sizeof(res) || res.size % SnapshotHeader::alignment != 0){
+            throw std::length_error("Snapshot size is not a whole number of 64 byte blocks");
+        }
+        return res;
+    }
+
+    // Check that every index in the view lies in range, so that queries
+    // cannot read outside its arrays: the corners of the triangles are
+    // vertices, or the vertex at infinity in exactly the ghost triangles
+    // after the finite ones, every triangle has all three neighbors, since
+    // the ghosts close the mesh, neighbor links are mutual and join
+    // triangles sharing the edge between them, and the triangle around a
+    // vertex has it as a corner. One pass over the arrays, worth
+    // its cost on a memory-mapped snapshot from an untrusted source. It does
+    // not check that the triangulation is Delaunay.
+    void validate() const
+    {
+        const size_t n = size(), m = triangles_m.size();
+        if(coordinates_m[1].size() != n || finite_m > m || (!vertex_triangles_m.empty() && vertex_triangles_m.size() != n)){
+            throw std::invalid_argument("Triangulation arrays have inconsistent sizes");
+        }
+        for(size_t t = 0; t < m; t++){
+            const auto& ts = triangles_m[t];
+            if(std::ranges::count(ts, infinite_vertex) != (t < finite_m ? 0 : 1)){
+                throw std::invalid_argument("Triangle " + std::to_string(t) + (t < finite_m ? " is finite but has a corner at infinity"
+                                                                                            : " is a ghost without exactly one corner at infinity"));
+            }
+            for(Int k = 0; k < 3; k++){
+                const Int v = ts.vertices()[k];
+                if(v != infinite_vertex && v >= n){
+                    throw std::invalid_argument("Triangle " + std::to_string(t) + " has a corner out of range");
+                }
+                const auto u = ts.neighbors()[k];
+                if(!u){
+                    throw std::invalid_argument("Triangle " + std::to_string(t) + " is missing a neighbor");
+                }
+                if(*u >= m || std::ranges::find(triangles_m[*u].neighbors(), static_cast<Int>(t)) == std::end(triangles_m[*u].neighbors())){
+                    throw std::invalid_argument("Triangle " + std::to_string(t) + " has a neighbor out of range or one not linked back to it");
+                }
+                const auto& us = triangles_m[*u];
+                if(std::ranges::find(us, ts.vertices()[(k + 1) % 3]) == std::end(us) || std::ranges::find(us, ts.vertices()[(k + 2) % 3]) == std::end(us)){
+                    throw std::invalid_argument("Triangle " + std::to_string(t) + " has a neighbor not sharing the edge between them");
+                }
+            }
+        }
+        for(size_t v = 0; v < vertex_triangles_m.size(); v++){
+            const Int t = vertex_triangles_m[v];
+            if(t != OptionalIndex<Int>::none && (t >= m || std::ranges::find(triangles_m[t], v) == std::end(triangles_m[t]))){
+                throw std::invalid_argument("Vertex " + std::to_string(v) + " has a triangle out of range or one without it as a corner");
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return coordinates_m[0].size();
+    }
+
+    size_t triangle_count() const
+    {
+        return finite_m;
+    }
+
+    bool has_vertex_triangles() const
+    {
+        return !vertex_triangles_m.empty();
+    }
+
+    // Coordinate d of every vertex
+    std::span<const Float> coordinates(const size_t d) const
+    {
+        return coordinates_m[d];
+    }
+
+    Vertex<Float> vertex(const Int v) const
+    {
+        return {coordinates_m[0][v], coordinates_m[1][v]};
+    }
+
+    // The finite triangles, neighbor links across the convex hull pointing
+    // at ghost triangles from triangles_view().size() on
+    std::span<const Triangle<Int>> triangles_view() const
+    {
+        return triangles_m.first(finite_m);
+    }
+
+    // Every triangle slot, the ghost triangles after the finite ones
+    std::span<const Triangle<Int>> triangle_slots() const
+    {
+        return triangles_m;
+    }
+
+    // A triangle around vertex v, or nothing if v is not part of the
+    // triangulation or the view has no triangles around vertices
+    OptionalIndex<Int> vertex_triangle(const Int v) const
+    {
+        if(v >= vertex_triangles_m.size()){
+            return std::nullopt;
+        }
+        return vertex_triangles_m[v];
+    }
+
+    // The neighbors of vertex v and the finite triangles around it, both
+    // counterclockwise and laid out as in Adjacency
+    std::vector<Int> vertex_neighbors(const Int v) const
+    {
+        std::vector<Int> res;
+        for_each_around(v, [&](const Int s, const Int k)
+            {
+                const Int u = triangles_m[s].vertices()[(k + 1) % 3];
+                if(u != infinite_vertex){
+                    res.push_back(u);
+                }
+            });
+        return res;
+    }
+
+    std::vector<Int> vertex_triangles(const Int v) const
+    {
+        std::vector<Int> res;
+        for_each_around(v, [&](const Int s, const Int)
+            {
+                if(s < finite_m){
+                    res.push_back(s);
+                }
+            });
+        return res;
+    }
+
+    // Remembering stochastic walk through the neighbor links, starting from t.
+    // Returns the triangle containing p, whether p lies inside it, on one of
+    // its edges or on one of its vertices, and the local index of that edge
+    // (numbered by the opposite vertex) or vertex. Points outside the convex
+    // hull are located in a ghost triangle whose hull edge they can see, with
+    // the local index of the vertex at infinity. The steps taken and the
+    // orientation tests made are added to steps and tests.
+    template<class Rng>
+    std::tuple<Int, Location, Int> walk(const Vertex<Float>& p, Int t, Rng& rng, size_t& steps, size_t& tests) const
+    {
+        std::optional<Int> previous;
+        bool moved = true;
+        while(moved){
+            moved = false;
+            const auto& vs = triangles_m[t].vertices();
+            const auto& ns = triangles_m[t].neighbors();
+            if(is_ghost(triangles_m[t])){
+                Int k = static_cast<Int>(std::ranges::find(vs, infinite_vertex) - std::begin(vs));
+                tests++;
+                if(orientation(vs[(k + 1) % 3], vs[(k + 2) % 3], p) <= 0){
+                    previous = t;
+                    t = *ns[k];
+                    moved = true;
+                    steps++;
+                }
+                continue;
+            }
+            Int offset = static_cast<Int>(rng() % 3);
+            for(Int k = 0; k < 3 && !moved; k++){
+                Int e = (offset + k) % 3;
+                if(!ns[e] || ns[e] == previous){
+                    continue;
+                }
+                tests++;
+                if(orientation(vs[(e + 1) % 3], vs[(e + 2) % 3], p) < 0){
+                    previous = t;
+                    t = *ns[e];
+                    moved = true;
+                    steps++;
+                }
+            }
+        }
+        const auto& vs = triangles_m[t].vertices();
+        if(is_ghost(triangles_m[t])){
+            return {t, Location::outside, static_cast<Int>(std::ranges::find(vs, infinite_vertex) - std::begin(vs))};
+        }
+        std::array<bool, 3> on_edge;
+        tests += 3;
+        for(Int e = 0; e < 3; e++){
+            on_edge[e] = orientation(vs[(e + 1) % 3], vs[(e + 2) % 3], p) == 0;
+        }
+        switch(std::ranges::count(on_edge, true)){
+            case 0:
+                return {t, Location::inside, 0};
+            case 1:
+                return {t, Location::edge, static_cast<Int>(std::ranges::find(on_edge, true) - std::begin(on_edge))};
+            default:
+                return {t, Location::vertex, static_cast<Int>(std::ranges::find(on_edge, false) - std::begin(on_edge))};
+        }
+    }
+
+    // Triangle containing p, as returned by walk(), found by walking from
+    // triangle hint, e.g. the one found for a point nearby
+    std::tuple<Int, Location, Int> locate(const Vertex<Float>& p, const Int hint = 0) const
+    {
+        if(finite_m == 0){
+            throw std::logic_error("Point location needs a triangulation with at least one triangle");
+        }
+        std::minstd_rand rng(hint);
+        size_t steps = 0, tests = 0;
+        return walk(p, hint < triangles_m.size() ? hint : 0, rng, steps, tests);
+    }
+
+    // Greedy descent to the vertex closest to p, starting from the closest
+    // corner of triangle t and stepping to a closer neighbor while there is
+    // one. In a Delaunay triangulation only the nearest vertex has none.
+    // Returns the vertex and a triangle around it.
+    std::tuple<Int, Int> descend(const Vertex<Float>& p, Int t) const
+    {
+        Int v = infinite_vertex;
+        Float d = std::numeric_limits<Float>::max();
+        for(const Int w : triangles_m[t]){
+            if(w != infinite_vertex && dist2(vertex(w), p) < d){
+                d = dist2(vertex(w), p);
+                v = w;
+            }
+        }
+        bool moved = true;
+        while(moved){
+            moved = false;
+            Int s = t;
+            do{
+                const auto& ts = triangles_m[s];
+                Int i = static_cast<Int>(std::ranges::find(ts, v) - std::begin(ts));
+                Int u = ts.vertices()[(i + 1) % 3];
+                if(u != infinite_vertex && dist2(vertex(u), p) < d){
+                    d = dist2(vertex(u), p);
+                    v = u;
+                    t = s;
+                    moved = true;
+                    break;
+                }
+                s = *ts.neighbors()[(i + 1) % 3];
+            }while(s != t);
+        }
+        return {v, t};
+    }
+
+    // Vertex closest to p, see locate() for the hint
+    Int nearest_vertex(const Vertex<Float>& p, const Int hint = 0) const
+    {
+        return std::get<0>(descend(p, std::get<0>(locate(p, hint))));
+    }
+
+    // Scratch space of k_nearest(), which a batch of queries can share so
+    // that it allocates only while the space grows
+    struct NearestScratch{
+        // Distance, vertex and a triangle around it, as a heap closest first
+        std::vector<std::tuple<Float, Int, Int>> candidates;
+        // Vertices queued so far, as an open addressing hash set of a power
+        // of two slots, at most half of them used and the empty ones holding
+        // infinite_vertex
+        std::vector<Int> seen;
+        size_t seen_count = 0;
+
+        // Whether v was not seen before
+        bool see(const Int v)
+        {
+            if(2*(seen_count + 1) > seen.size()){
+                std::vector<Int> old(std::max<size_t>(2*seen.size(), 64), infinite_vertex);
+                std::swap(seen, old);
+                seen_count = 0;
+                for(const Int u : old){
+                    if(u != infinite_vertex){
+                        see(u);
+                    }
+                }
+            }
+            const size_t mask = seen.size() - 1;
+            for(size_t i = (static_cast<uint64_t>(v)*0x9e3779b97f4a7c15) >> (64 - std::countr_zero(seen.size())); ; i = (i + 1) & mask){
+                if(seen[i] == v){
+                    return false;
+                }
+                if(seen[i] == infinite_vertex){
+                    seen[i] = v;
+                    seen_count++;
+                    return true;
+                }
+            }
+        }
+    };
+
+    // The vertices closest to p, closest first, as many as out has room
+    // for. The Delaunay graph links every vertex among them to a closer one,
+    // so they are found by a best first search from the nearest vertex.
+    // Returns how many were written, fewer if the view has fewer vertices.
+    size_t k_nearest(const Vertex<Float>& p, std::span<Int> out, const Int hint, NearestScratch& scratch) const
+    {
+        if(out.empty()){
+            return 0;
+        }
+        auto& candidates = scratch.candidates;
+        candidates.clear();
+        std::ranges::fill(scratch.seen, infinite_vertex);
+        scratch.seen_count = 0;
+        auto [v, t] = descend(p, std::get<0>(locate(p, hint)));
+        candidates.emplace_back(dist2(vertex(v), p), v, t);
+        scratch.see(v);
+        size_t found = 0;
+        while(found < out.size() && !candidates.empty()){
+            std::ranges::pop_heap(candidates, std::greater<>());
+            auto [d, w, s] = candidates.back();
+            candidates.pop_back();
+            out[found++] = w;
+            const Int first = s;
+            do{
+                const auto& ts = triangles_m[s];
+                Int i = static_cast<Int>(std::ranges::find(ts, w) - std::begin(ts));
+                Int u = ts.vertices()[(i + 1) % 3];
+                if(u != infinite_vertex && scratch.see(u)){
+                    candidates.emplace_back(dist2(vertex(u), p), u, s);
+                    std::ranges::push_heap(candidates, std::greater<>());
+                }
+                s = *ts.neighbors()[(i + 1) % 3];
+            }while(s != first);
+        }
+        return found;
+    }
+
+    std::vector<Int> k_nearest(const Vertex<Float>& p, const size_t k, const Int hint = 0) const
+    {
+        NearestScratch scratch;
+        std::vector<Int> res(k);
+        res.resize(k_nearest(p, res, hint, scratch));
+        return res;
+    }
+};
+
+#if __has_include(<sys/mman.h>)
+// Read-only memory map of a whole file, e.g. a snapshot to use through
+// DelaunayView. Pages are read from the file on first access.
+class MappedFile{
+private:
+    void* data_m = nullptr;
+    size_t size_m = 0;
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "Could not open " + path);
+        }
+        struct stat st;
+        if(::fstat(fd, &st) != 0){
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Could not read the size of " + path);
+        }
+        size_m = static_cast<size_t>(st.st_size);
+        if(size_m > 0){
+            data_m = ::mmap(nullptr, size_m, PROT_READ, MAP_SHARED, fd, 0);
+            if(data_m == MAP_FAILED){
+                const int error = errno;
+                ::close(fd);
+                data_m = nullptr;
+                throw std::system_error(error, std::generic_category(), "Could not map " + path);
+            }
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& m)
+     : data_m(std::exchange(m.data_m, nullptr)), size_m(std::exchange(m.size_m, 0))
+    {}
+
+    ~MappedFile()
+    {
+        if(data_m != nullptr){
+            ::munmap(data_m, size_m);
+        }
+    }
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& m)
+    {
+        std::swap(data_m, m.data_m);
+        std::swap(size_m, m.size_m);
+        return *this;
+    }
+
+    std::span<const std::byte> bytes() const
+    {
+        return {static_cast<const std::byte*>(data_m), size_m};
+    }
+};
+#endif
+
+#endif // DELAUNAY_SNAPSHOT_LIB_H
@@ -0,0 +1,615 @@
+#ifndef DELAUNAY_STREAMING_LIB_H
+#define DELAUNAY_STREAMING_LIB_H
+
+#include "delaunay-triangulation.h"
+
+// Streaming Delaunay triangulation of point sets too large for memory,
+// after Isenburg, Liu, Shewchuk and Snoeyink, "Streaming computation of
+// Delaunay triangulations". The points lie in a grid of cells and are read
+// in spatially coherent chunks, interleaved with finalization markers
+// saying that a cell gets no more points. A triangle is final once its
+// circumcircle only meets finalized cells, as no later point can fall
+// inside it. It is then handed to the sink and dropped, together with the
+// vertices no live triangle uses any more, so memory is bounded by the
+// triangles along the edge of the finalized region rather than by the
+// input. Each triangle is handed over counterclockwise, with the index of
+// every corner in the order the points were read and its coordinates.
+template<Numeric Float, Integral Int>
+class StreamingDelaunay{
+public:
+    using Sink = std::function<void(const Triangle<Int>&, const Triangle<Float>&)>;
+    static constexpr Int infinite_vertex = std::numeric_limits<Int>::max();
+private:
+    // A triangle waiting for a cell to be finalized, or to be handed over if
+    // it is on ready_m. The cells it meets before cell from in row order are
+    // known to be finalized. Slots are reused, so the generation of the slot
+    // tells whether it still holds the same triangle.
+    struct Waiting{
+        Int triangle;
+        uint32_t generation;
+        size_t from;
+    };
+
+    Grid<Float> cells_m;
+    Sink sink_m;
+    // Vertex slots are reused once no live triangle uses them
+    VertexStore<Float> vertices_m;
+    std::vector<Int> global_m;
+    std::vector<uint32_t> references_m;
+    std::vector<Int> free_vertices_m;
+    TrianglePool<Int> triangles_m;
+    std::vector<uint32_t> generation_m;
+    std::vector<bool> finalized_m;
+    std::vector<std::vector<Waiting>> waiting_m;
+    std::vector<Waiting> ready_m;
+    // Points read before the first three that are not collinear
+    std::vector<std::tuple<Int, Vertex<Float>>> pending_m;
+    Int hint_m = 0;
+    Int points_m = 0;
+    size_t emitted_m = 0;
+    size_t peak_m = 0;
+    std::minstd_rand rng_m;
+    std::vector<Int> cavity_m;
+    std::vector<uint8_t> in_cavity_m;
+    std::vector<std::tuple<Int, Int, OptionalIndex<Int>, Int>> boundary_m;
+    std::vector<std::pair<Int, Int>> by_start_m;
+    std::vector<std::pair<Int, Int>> by_end_m;
+    std::vector<Int> created_m;
+
+    double extent() const
+    {
+        return std::max(static_cast<double>(cells_m.nx)*static_cast<double>(cells_m.dx),
+                        static_cast<double>(cells_m.ny)*static_cast<double>(cells_m.dy));
+    }
+
+    bool is_ghost(const Int t) const
+    {
+        return std::ranges::find(triangles_m[t], infinite_vertex) != std::end(triangles_m[t]);
+    }
+
+    Float orientation(const Int a, const Int b, const Vertex<Float>& p) const
+    {
+        return orient2d<Float>(vertices_m.coordinate(0, a), vertices_m.coordinate(1, a),
+                               vertices_m.coordinate(0, b), vertices_m.coordinate(1, b), p.x(), p.y());
+    }
+
+    // The hull edge of a ghost triangle, seen from inside the hull as going
+    // clockwise
+    std::array<Int, 2> hull_edge(const Int t) const
+    {
+        const auto& vs = triangles_m[t].vertices();
+        const auto k = static_cast<Int>(std::ranges::find(vs, infinite_vertex) - std::begin(vs));
+        return {vs[(k + 1) % 3], vs[(k + 2) % 3]};
+    }
+
+    // As Delaunay::circumcircle_contains()
+    bool circumcircle_contains(const Int t, const Vertex<Float>& p) const
+    {
+        if(is_ghost(t)){
+            auto [a, b] = hull_edge(t);
+            Float o = orientation(a, b, p);
+            if(o != 0){
+                return o > 0;
+            }
+            auto between = [](const Float u, const Float v, const Float w) {return (u < v && v < w) || (w < v && v < u);};
+            return between(vertices_m.coordinate(0, a), p.x(), vertices_m.coordinate(0, b))
+                || between(vertices_m.coordinate(1, a), p.y(), vertices_m.coordinate(1, b));
+        }
+        auto [a, b, c] = triangles_m[t].vertices();
+        return incircle<Float>(vertices_m.coordinate(0, a), vertices_m.coordinate(1, a), vertices_m.coordinate(0, b), vertices_m.coordinate(1, b),
+                               vertices_m.coordinate(0, c), vertices_m.coordinate(1, c), p.x(), p.y()) > 0;
+    }
+
+    // Whether triangle t contains p, or for a ghost triangle whether p lies
+    // strictly beyond its hull edge
+    bool contains(const Int t, const Vertex<Float>& p) const
+    {
+        if(is_ghost(t)){
+            auto [a, b] = hull_edge(t);
+            return orientation(a, b, p) > 0;
+        }
+        auto [a, b, c] = triangles_m[t].vertices();
+        return orientation(a, b, p) >= 0 && orientation(b, c, p) >= 0 && orientation(c, a, p) >= 0;
+    }
+
+    Int add_vertex(const Vertex<Float>& p, const Int global)
+    {
+        Int v;
+        if(free_vertices_m.empty()){
+            v = static_cast<Int>(vertices_m.size());
+            vertices_m.push_back(p);
+            global_m.push_back(global);
+            references_m.push_back(0);
+        }else{
+            v = free_vertices_m.back();
+            free_vertices_m.pop_back();
+            vertices_m[v] = p;
+            global_m[v] = global;
+        }
+        return v;
+    }
+
+    Int add_triangle(const Triangle<Int>& t)
+    {
+        const Int s = triangles_m.allocate(t);
+        if(generation_m.size() < triangles_m.size()){
+            generation_m.resize(triangles_m.size(), 0);
+        }
+        for(const Int v : t){
+            if(v != infinite_vertex){
+                references_m[v]++;
+            }
+        }
+        peak_m = std::max(peak_m, triangles_m.live());
+        return s;
+    }
+
+    void drop_triangle(const Int t)
+    {
+        for(const Int v : triangles_m[t]){
+            if(v != infinite_vertex && --references_m[v] == 0){
+                free_vertices_m.push_back(v);
+            }
+        }
+        generation_m[t]++;
+        triangles_m.release(t);
+    }
+
+    // Cells from the one containing lo to the one containing hi, in one
+    // direction
+    static std::array<size_t, 2> cell_range(const double lo, const double hi, const double origin, const double size, const size_t n)
+    {
+        auto index = [&](const double x)
+        {
+            const double i = std::floor((x - origin)/size);
+            return i <= 0 ? size_t(0) : (i >= static_cast<double>(n - 1) ? n - 1 : static_cast<size_t>(i));
+        };
+        return {index(lo), index(hi)};
+    }
+
+    // The first cell, from cell from on in row order, that is not finalized
+    // and that the circumcircle of triangle t meets, or for a ghost triangle
+    // the closed half-plane beyond its hull edge. Circles and half-planes are
+    // grown a little to make up for rounding, which can only keep a triangle
+    // waiting for longer.
+    std::optional<size_t> blocking_cell(const Int t, const size_t from) const
+    {
+        const double x0 = cells_m.x0, y0 = cells_m.y0, dx = cells_m.dx, dy = cells_m.dy;
+        const size_t nx = cells_m.nx, ny = cells_m.ny;
+        const double size = extent();
+        if(is_ghost(t)){
+            auto [a, b] = hull_edge(t);
+            const double ax = vertices_m.coordinate(0, a), ay = vertices_m.coordinate(1, a);
+            const double bx = vertices_m.coordinate(0, b), by = vertices_m.coordinate(1, b);
+            const double slack = 1e-9*std::hypot(bx - ax, by - ay)*size;
+            auto side = [=](const double x, const double y) {return (bx - ax)*(y - ay) - (by - ay)*(x - ax) + slack;};
+            // Bounding box of the part of the grid beyond the hull edge
+            const double width = static_cast<double>(nx)*dx, height = static_cast<double>(ny)*dy;
+            const std::array<std::array<double, 2>, 4> corners{{{x0, y0}, {x0 + width, y0}, {x0 + width, y0 + height}, {x0, y0 + height}}};
+            double xmin = std::numeric_limits<double>::max(), xmax = -xmin, ymin = xmin, ymax = -xmin;
+            auto add = [&](const double x, const double y)
+            {
+                xmin = std::min(xmin, x);
+                xmax = std::max(xmax, x);
+                ymin = std::min(ymin, y);
+                ymax = std::max(ymax, y);
+            };
+            for(size_t k = 0; k < 4; k++){
+                auto [px, py] = corners[k];
+                auto [qx, qy] = corners[(k + 1) % 4];
+                const double sp = side(px, py), sq = side(qx, qy);
+                if(sp >= 0){
+                    add(px, py);
+                }
+                if((sp < 0) != (sq < 0)){
+                    const double f = sp/(sp - sq);
+                    add(px + f*(qx - px), py + f*(qy - py));
+                }
+            }
+            if(xmin > xmax){
+                return std::nullopt;
+            }
+            return first_cell(cell_range(xmin, xmax, x0, dx, nx), cell_range(ymin, ymax, y0, dy, ny), from,
+                [&](const double lx, const double ly, const double hx, const double hy)
+                {
+                    return side(lx, ly) >= 0 || side(hx, ly) >= 0 || side(hx, hy) >= 0 || side(lx, hy) >= 0;
+                });
+        }else{
+            auto [a, b, c] = triangles_m[t].vertices();
+            const double ax = vertices_m.coordinate(0, a), ay = vertices_m.coordinate(1, a);
+            auto [cx, cy] = circumcenter<double>(ax, ay, vertices_m.coordinate(0, b), vertices_m.coordinate(1, b),
+                                                 vertices_m.coordinate(0, c), vertices_m.coordinate(1, c));
+            const double r = std::hypot(cx - ax, cy - ay)*(1 + 1e-7) + 1e-9*size;
+            if(!std::isfinite(r)){
+                return first_cell({0, nx - 1}, {0, ny - 1}, from, [](double, double, double, double) {return true;});
+            }
+            return first_cell(cell_range(cx - r, cx + r, x0, dx, nx), cell_range(cy - r, cy + r, y0, dy, ny), from,
+                [&](const double lx, const double ly, const double hx, const double hy)
+                {
+                    const double ex = std::max({lx - cx, 0., cx - hx}), ey = std::max({ly - cy, 0., cy - hy});
+                    return ex*ex + ey*ey <= r*r;
+                });
+        }
+    }
+
+    // The first cell in columns is and rows js, from cell from on in row
+    // order, that is not finalized and whose box meets(lo x, lo y, hi x, hi y)
+    template<class Meets>
+    std::optional<size_t> first_cell(const std::array<size_t, 2> is, const std::array<size_t, 2> js, const size_t from, Meets&& meets) const
+    {
+        const double x0 = cells_m.x0, y0 = cells_m.y0, dx = cells_m.dx, dy = cells_m.dy;
+        const size_t nx = cells_m.nx;
+        for(size_t j = std::max(js[0], from/nx); j <= js[1]; j++){
+            for(size_t i = j == from/nx ? std::max(is[0], from % nx) : is[0]; i <= is[1]; i++){
+                const size_t k = j*nx + i;
+                const double ci = static_cast<double>(i), cj = static_cast<double>(j);
+                if(!finalized_m[k] && meets(x0 + ci*dx, y0 + cj*dy, x0 + (ci + 1)*dx, y0 + (cj + 1)*dy)){
+                    return k;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Let triangle t wait for the next cell from cell from on that keeps it
+    // from being final, or mark it ready if there is none
+    void schedule(const Int t, const size_t from = 0)
+    {
+        if(auto k = blocking_cell(t, from)){
+            waiting_m[*k].push_back({t, generation_m[t], *k});
+        }else{
+            ready_m.push_back({t, generation_m[t], 0});
+        }
+    }
+
+    // Hand the final triangles to the sink and drop them
+    void emit_ready()
+    {
+        while(!ready_m.empty()){
+            const auto w = ready_m.back();
+            ready_m.pop_back();
+            const Int t = w.triangle;
+            if(!triangles_m.alive(t) || generation_m[t] != w.generation){
+                continue;
+            }
+            if(!is_ghost(t)){
+                auto [a, b, c] = triangles_m[t].vertices();
+                sink_m(Triangle<Int>(global_m[a], global_m[b], global_m[c]),
+                       Triangle<Float>{Vertex<Float>(vertices_m[a]), Vertex<Float>(vertices_m[b]), Vertex<Float>(vertices_m[c])});
+                emitted_m++;
+            }
+            for(const auto& n : triangles_m[t].neighbors()){
+                if(n){
+                    for(auto& m : triangles_m[*n].neighbors()){
+                        if(m == OptionalIndex<Int>(t)){
+                            m.reset();
+                        }
+                    }
+                }
+            }
+            drop_triangle(t);
+        }
+    }
+
+    // Walk towards p as Delaunay does, with finalized neighbors as walls.
+    // Returns a triangle containing p, or a ghost triangle whose hull edge p
+    // lies strictly beyond. Should the walk get stuck behind finalized
+    // triangles, the live ones are searched instead.
+    Int locate(const Vertex<Float>& p)
+    {
+        Int t = hint_m;
+        if(t >= triangles_m.size() || !triangles_m.alive(t)){
+            t = 0;
+            while(!triangles_m.alive(t)){
+                t++;
+            }
+        }
+        std::optional<Int> previous;
+        bool moved = true;
+        while(moved){
+            moved = false;
+            const auto& vs = triangles_m[t].vertices();
+            const auto& ns = triangles_m[t].neighbors();
+            if(is_ghost(t)){
+                Int k = static_cast<Int>(std::ranges::find(vs, infinite_vertex) - std::begin(vs));
+                if(ns[k] && orientation(vs[(k + 1) % 3], vs[(k + 2) % 3], p) <= 0){
+                    previous = t;
+                    t = *ns[k];
+                    moved = true;
+                }
+                continue;
+            }
+            Int offset = static_cast<Int>(rng_m() % 3);
+            for(Int k = 0; k < 3 && !moved; k++){
+                Int e = (offset + k) % 3;
+                if(!ns[e] || ns[e] == previous){
+                    continue;
+                }
+                if(orientation(vs[(e + 1) % 3], vs[(e + 2) % 3], p) < 0){
+                    previous = t;
+                    t = *ns[e];
+                    moved = true;
+                }
+            }
+        }
+        if(contains(t, p)){
+            return t;
+        }
+        for(Int s = 0; s < triangles_m.size(); s++){
+            if(triangles_m.alive(s) && contains(s, p)){
+                return s;
+            }
+        }
+        throw std::logic_error("No live triangle contains the point");
+    }
+
+    // Bowyer-Watson insertion of p into the triangles whose circumcircles
+    // contain it, starting from triangle t containing it. Returns the index
+    // of p, or of the point read before at the same position.
+    Int insert_at(const Vertex<Float>& p, const Int t, const Int global)
+    {
+        if(!is_ghost(t)){
+            for(const Int v : triangles_m[t]){
+                if(vertices_m[v] == p){
+                    return global_m[v];
+                }
+            }
+        }
+        const Int v = add_vertex(p, global);
+        in_cavity_m.resize(triangles_m.size(), false);
+        cavity_m.assign(1, t);
+        in_cavity_m[t] = true;
+        for(size_t i = 0; i < cavity_m.size(); i++){
+            for(const auto& n : triangles_m[cavity_m[i]].neighbors()){
+                if(n && !in_cavity_m[*n] && circumcircle_contains(*n, p)){
+                    in_cavity_m[*n] = true;
+                    cavity_m.push_back(*n);
+                }
+            }
+        }
+        boundary_m.clear();
+        for(const Int c : cavity_m){
+            const auto& vs = triangles_m[c].vertices();
+            const auto& ns = triangles_m[c].neighbors();
+            for(Int e = 0; e < 3; e++){
+                if(!ns[e] || !in_cavity_m[*ns[e]]){
+                    boundary_m.emplace_back(vs[(e + 1) % 3], vs[(e + 2) % 3], ns[e], c);
+                }
+            }
+        }
+        for(const Int c : cavity_m){
+            in_cavity_m[c] = false;
+        }
+        // The boundary is a closed polygon around p, so every corner starts
+        // one edge and ends one
+        created_m.clear();
+        by_start_m.clear();
+        by_end_m.clear();
+        for(const auto& [a, b, outside, inner] : boundary_m){
+            const Int s = add_triangle(Triangle<Int>(a, b, v));
+            triangles_m[s].neighbors()[2] = outside;
+            if(outside){
+                auto& o = triangles_m[*outside];
+                const auto k = static_cast<Int>(std::ranges::find_if(o.vertices(), [a, b](const Int w) {return w != a && w != b;}) - std::begin(o.vertices()));
+                o.neighbors()[k] = s;
+            }
+            created_m.push_back(s);
+            by_start_m.emplace_back(a, s);
+            by_end_m.emplace_back(b, s);
+        }
+        std::ranges::sort(by_start_m);
+        std::ranges::sort(by_end_m);
+        auto find = [](const std::vector<std::pair<Int, Int>>& edges, const Int w)
+        {
+            return std::ranges::lower_bound(edges, std::pair<Int, Int>(w, 0))->second;
+        };
+        for(const Int s : created_m){
+            auto& ts = triangles_m[s];
+            ts.neighbors()[0] = find(by_start_m, ts.vertices()[1]);
+            ts.neighbors()[1] = find(by_end_m, ts.vertices()[0]);
+        }
+        for(const Int c : cavity_m){
+            drop_triangle(c);
+        }
+        // Most new triangles are gone again long before they could be final,
+        // so they wait on the cell of p, which their circumcircles pass
+        // through, and are only checked against the other cells once it is
+        // finalized. Points read before the first triangle may be inserted
+        // after their cell is finalized, their triangles are scheduled at once.
+        auto [i, j] = cell(p);
+        const size_t k = j*cells_m.nx + i;
+        for(const Int s : created_m){
+            if(finalized_m[k]){
+                schedule(s);
+            }else{
+                waiting_m[k].push_back({s, generation_m[s], 0});
+            }
+        }
+        hint_m = created_m.back();
+        return global;
+    }
+
+    // Build the first triangle once three points that are not collinear have
+    // been read, and insert the other points read so far
+    void start()
+    {
+        const auto& [g0, p0] = pending_m[0];
+        auto second = std::ranges::find_if(pending_m, [&p0](const auto& q) {return std::get<1>(q) != p0;});
+        if(second == std::end(pending_m)){
+            return;
+        }
+        const auto& [g1, p1] = *second;
+        auto third = std::ranges::find_if(pending_m, [&](const auto& q)
+            {
+                const auto& r = std::get<1>(q);
+                return orient2d<Float>(p0.x(), p0.y(), p1.x(), p1.y(), r.x(), r.y()) != 0;
+            });
+        if(third == std::end(pending_m)){
+            return;
+        }
+        const auto& [g2, p2] = *third;
+        Int a = add_vertex(p0, g0), b = add_vertex(p1, g1), c = add_vertex(p2, g2);
+        if(orient2d<Float>(p0.x(), p0.y(), p1.x(), p1.y(), p2.x(), p2.y()) < 0){
+            std::swap(b, c);
+        }
+        const auto first = static_cast<Int>(triangles_m.size());
+        add_triangle(Triangle<Int>({a, b, c}, {first + 1, first + 2, first + 3}));
+        add_triangle(Triangle<Int>({c, b, infinite_vertex}, {first + 3, first + 2, first}));
+        add_triangle(Triangle<Int>({a, c, infinite_vertex}, {first + 1, first + 3, first}));
+        add_triangle(Triangle<Int>({b, a, infinite_vertex}, {first + 2, first + 1, first}));
+        for(Int t = first; t < first + 4; t++){
+            schedule(t);
+        }
+        hint_m = first;
+        const std::array<Int, 3> used{g0, g1, g2};
+        auto rest = std::move(pending_m);
+        pending_m.clear();
+        for(const auto& [g, q] : rest){
+            if(std::ranges::find(used, g) == std::end(used)){
+                insert_at(q, locate(q), g);
+            }
+        }
+    }
+
+    size_t check_cell(const Vertex<Float>& p) const
+    {
+        auto [i, j] = cell(p);
+        const size_t k = j*cells_m.nx + i;
+        if(finalized_m[k]){
+            throw std::logic_error("Point lies in a finalized cell");
+        }
+        return k;
+    }
+
+    Int insert_point(const Vertex<Float>& p, const Int global)
+    {
+        if(triangles_m.live() == 0){
+            for(const auto& [g, q] : pending_m){
+                if(q == p){
+                    return g;
+                }
+            }
+            pending_m.emplace_back(global, p);
+            start();
+            emit_ready();
+            return global;
+        }
+        Int res = insert_at(p, locate(p), global);
+        emit_ready();
+        return res;
+    }
+public:
+    // Cell (i, j) runs from cells(i, j) to cells(i + 1, j + 1)
+    StreamingDelaunay(const Grid<Float>& cells, Sink sink)
+     : cells_m(cells), sink_m(std::move(sink)), finalized_m(cells.size(), false), waiting_m(cells.size())
+    {
+        if(cells.size() == 0 || !(cells.dx > 0) || !(cells.dy > 0)){
+            throw std::invalid_argument("Cell grid must have cells of positive size");
+        }
+    }
+
+    const Grid<Float>& cells() const
+    {
+        return cells_m;
+    }
+
+    // The cell containing p, points on the far edges of the grid belonging
+    // to the last row or column
+    std::array<size_t, 2> cell(const Vertex<Float>& p) const
+    {
+        const double fx = (static_cast<double>(p.x()) - cells_m.x0)/cells_m.dx;
+        const double fy = (static_cast<double>(p.y()) - cells_m.y0)/cells_m.dy;
+        const auto nx = static_cast<double>(cells_m.nx), ny = static_cast<double>(cells_m.ny);
+        if(!(fx >= 0 && fx <= nx && fy >= 0 && fy <= ny)){
+            throw std::out_of_range("Point lies outside the grid of cells");
+        }
+        return {std::min(static_cast<size_t>(fx), cells_m.nx - 1), std::min(static_cast<size_t>(fy), cells_m.ny - 1)};
+    }
+
+    // Add the next point, which must not lie in a finalized cell. Returns its
+    // index, or that of the point read before at the same position.
+    Int insert(const Vertex<Float>& p)
+    {
+        check_cell(p);
+        return insert_point(p, points_m++);
+    }
+
+    // Add a chunk of points, inserted along a Hilbert curve. They get
+    // consecutive indices in the given order.
+    std::vector<Int> insert(std::span<const Vertex<Float>> points)
+    {
+        for(const auto& p : points){
+            check_cell(p);
+        }
+        std::vector<Int> res(points.size());
+        const Int base = points_m;
+        points_m += static_cast<Int>(points.size());
+        for(const Int i : hilbert_order<Int>(points)){
+            res[i] = insert_point(points[i], base + i);
+        }
+        return res;
+    }
+
+    // Finalization marker: cell (i, j) gets no more points. Triangles that
+    // became final are handed to the sink.
+    void finalize(const size_t i, const size_t j)
+    {
+        if(i >= cells_m.nx || j >= cells_m.ny){
+            throw std::out_of_range("Cell lies outside the grid");
+        }
+        const size_t k = j*cells_m.nx + i;
+        if(finalized_m[k]){
+            return;
+        }
+        finalized_m[k] = true;
+        auto waiting = std::move(waiting_m[k]);
+        waiting_m[k] = {};
+        for(const auto& w : waiting){
+            if(triangles_m.alive(w.triangle) && generation_m[w.triangle] == w.generation){
+                schedule(w.triangle, w.from);
+            }
+        }
+        emit_ready();
+    }
+
+    // Finalize every cell, handing over the remaining triangles
+    void finish()
+    {
+        for(size_t j = 0; j < cells_m.ny; j++){
+            for(size_t i = 0; i < cells_m.nx; i++){
+                finalize(i, j);
+            }
+        }
+        pending_m.clear();
+    }
+
+    // Points read so far
+    size_t size() const
+    {
+        return points_m;
+    }
+
+    size_t emitted() const
+    {
+        return emitted_m;
+    }
+
+    // Triangles held, ghost triangles along the convex hull included, now
+    // and at most so far
+    size_t active_triangles() const
+    {
+        return triangles_m.live();
+    }
+
+    size_t peak_triangles() const
+    {
+        return peak_m;
+    }
+
+    size_t active_vertices() const
+    {
+        return vertices_m.size() - free_vertices_m.size();
+    }
+};
+
+#endif // DELAUNAY_STREAMING_LIB_H
@@ -0,0 +1,441 @@
+#ifndef DELAUNAY_TETRAHEDRALIZATION_LIB_H
+#define DELAUNAY_TETRAHEDRALIZATION_LIB_H
+
+#include "delaunay-triangulation.h"
+
+// Delaunay tetrahedralization of points in space by incremental
+// Bowyer-Watson insertion in BRIO order. Each tetrahedron is four vertex
+// indices, positively oriented by orient3d, and four neighbor links, the
+// neighbor opposite vertex i in slot i. A link packs the neighbor and the
+// slot of the shared face in it as 4*t + j, so crossing a face needs no
+// search. As in the plane the convex hull is closed off by ghost
+// tetrahedra on an infinite vertex, a ghost being oriented as if the
+// infinite vertex lay far out beyond its hull face.
+template<Numeric Float, Integral Int = size_t>
+class Tetrahedralization{
+public:
+    using Tetrahedron = std::array<Int, 4>;
+
+    static constexpr Int infinite_vertex = std::numeric_limits<Int>::max();
+    static constexpr Int none = std::numeric_limits<Int>::max();
+private:
+    VertexStore<Float, 3> vertices_m;
+    std::vector<Tetrahedron> tetrahedra_m;
+    std::vector<Tetrahedron> neighbors_m;
+    Int finite_m = 0;
+
+    // Scratch space of insert, kept between insertions. A created
+    // tetrahedron goes with the link to its neighbor outside the cavity.
+    std::vector<uint8_t> in_cavity_m;
+    std::vector<Int> cavity_m;
+    std::vector<std::tuple<Tetrahedron, Int>> created_m;
+    std::vector<std::tuple<Int, Int, Int>> faces_m;
+    std::vector<Int> free_m;
+    std::minstd_rand rng_m;
+
+    // in_cavity_m of a slot on the free list
+    static constexpr uint8_t released = 2;
+
+    bool is_ghost(const Int t) const
+    {
+        return std::ranges::find(tetrahedra_m[t], infinite_vertex) != std::end(tetrahedra_m[t]);
+    }
+
+    Float orientation(const Int a, const Int b, const Int c, const Int d) const
+    {
+        auto pa = vertices_m[a], pb = vertices_m[b], pc = vertices_m[c], pd = vertices_m[d];
+        return orient3d(pa.x(), pa.y(), pa.z(), pb.x(), pb.y(), pb.z(),
+                        pc.x(), pc.y(), pc.z(), pd.x(), pd.y(), pd.z());
+    }
+
+    // Orientation of tetrahedron t with vertex i replaced by p, positive if p
+    // is on the same side of face i as vertex i
+    Float orientation(const Int t, const Int i, const Int p) const
+    {
+        auto v = tetrahedra_m[t];
+        v[i] = p;
+        return orientation(v[0], v[1], v[2], v[3]);
+    }
+
+    Float in_sphere(const Int t, const Int p) const
+    {
+        const auto& v = tetrahedra_m[t];
+        auto pa = vertices_m[v[0]], pb = vertices_m[v[1]], pc = vertices_m[v[2]], pd = vertices_m[v[3]];
+        auto pe = vertices_m[p];
+        return insphere(pa.x(), pa.y(), pa.z(), pb.x(), pb.y(), pb.z(), pc.x(), pc.y(), pc.z(),
+                        pd.x(), pd.y(), pd.z(), pe.x(), pe.y(), pe.z());
+    }
+
+    // Whether p lies inside the circumsphere of t. For a ghost that is p
+    // lying beyond its hull face, or in the plane of the face and inside its
+    // circumcircle, which is where the plane cuts the circumsphere of the
+    // finite tetrahedron on the other side.
+    bool conflict(const Int t, const Int p) const
+    {
+        const auto& v = tetrahedra_m[t];
+        const auto i = static_cast<Int>(std::ranges::find(v, infinite_vertex) - std::begin(v));
+        if(i == 4){
+            return in_sphere(t, p) > 0;
+        }
+        const Float o = orientation(t, i, p);
+        if(o != 0){
+            return o > 0;
+        }
+        return in_sphere(neighbors_m[t][i]/4, p) > 0;
+    }
+
+    void link(const Int t, const Int i, const Int link)
+    {
+        neighbors_m[t][i] = link;
+        neighbors_m[link/4][link%4] = 4*t + i;
+    }
+
+    Int allocate()
+    {
+        if(!free_m.empty()){
+            const Int t = free_m.back();
+            free_m.pop_back();
+            return t;
+        }
+        if(tetrahedra_m.size() >= std::numeric_limits<Int>::max()/4){
+            throw std::overflow_error("Tetrahedron links do not fit in the index type");
+        }
+        tetrahedra_m.emplace_back();
+        neighbors_m.emplace_back();
+        in_cavity_m.push_back(0);
+        return static_cast<Int>(tetrahedra_m.size() - 1);
+    }
+
+    // Walk from t towards p, crossing a face that has p on its far side
+    // until there is none. The faces are tried from a random one on, which
+    // keeps the walk from cycling. Returns a tetrahedron containing p, or a
+    // ghost whose hull face has p beyond it.
+    Int locate(Int t, const Int p)
+    {
+        if(is_ghost(t)){
+            const auto& v = tetrahedra_m[t];
+            t = neighbors_m[t][static_cast<size_t>(std::ranges::find(v, infinite_vertex) - std::begin(v))]/4;
+        }
+        Int from = 4;
+        while(!is_ghost(t)){
+            const Int start = rng_m() % 4;
+            Int next = 4;
+            for(Int k = 0; k < 4 && next == 4; k++){
+                const Int i = (start + k) % 4;
+                if(i != from && orientation(t, i, p) < 0){
+                    next = i;
+                }
+            }
+            if(next == 4){
+                break;
+            }
+            const Int l = neighbors_m[t][next];
+            t = l/4;
+            from = l%4;
+        }
+        return t;
+    }
+
+    // Insert vertex p by Bowyer-Watson, starting the search at hint.
+    // Returns a new tetrahedron, or one at the vertex p duplicates.
+    Int insert(const Int p, const Int hint)
+    {
+        const Int t = locate(hint, p);
+        for(const Int v : tetrahedra_m[t]){
+            if(v != infinite_vertex && vertices_m[v] == vertices_m[p]){
+                return t;
+            }
+        }
+
+        // Cavity of the tetrahedra whose circumspheres contain p, and the
+        // tetrahedra filling it, one per face on its boundary. A new
+        // tetrahedron is the cavity one with the vertex opposite the face
+        // replaced by p, which keeps it positively oriented.
+        cavity_m.assign(1, t);
+        in_cavity_m[t] = 1;
+        created_m.clear();
+        for(size_t k = 0; k < cavity_m.size(); k++){
+            const Int c = cavity_m[k];
+            for(Int i = 0; i < 4; i++){
+                const Int n = neighbors_m[c][i]/4;
+                if(in_cavity_m[n]){
+                    continue;
+                }
+                if(conflict(n, p)){
+                    in_cavity_m[n] = 1;
+                    cavity_m.push_back(n);
+                }else{
+                    auto v = tetrahedra_m[c];
+                    v[i] = p;
+                    created_m.emplace_back(v, neighbors_m[c][i]);
+                }
+            }
+        }
+
+        // The new tetrahedra take the cavity slots, then released ones, then
+        // appended ones. Cavity slots left over are released. The inner
+        // faces, each holding p and an edge of the cavity boundary, are
+        // paired by that edge through a small hash table.
+        for(size_t k = created_m.size(); k < cavity_m.size(); k++){
+            in_cavity_m[cavity_m[k]] = released;
+            free_m.push_back(cavity_m[k]);
+        }
+        const size_t mask = std::bit_ceil(6*created_m.size()) - 1;
+        faces_m.assign(mask + 1, {0, 0, none});
+        size_t matched = 0;
+        Int res = cavity_m[0];
+        for(size_t k = 0; k < created_m.size(); k++){
+            const auto& [v, outer] = created_m[k];
+            const Int s = k < cavity_m.size() ? cavity_m[k] : allocate();
+            const auto i = static_cast<Int>(std::ranges::find(v, p) - std::begin(v));
+            tetrahedra_m[s] = v;
+            in_cavity_m[s] = 0;
+            link(s, i, outer);
+            for(Int j = 0; j < 4; j++){
+                if(j == i){
+                    continue;
+                }
+                std::array<Int, 2> e;
+                for(Int m = 0, l = 0; m < 4; m++){
+                    if(m != i && m != j){
+                        e[l++] = v[m];
+                    }
+                }
+                const Int a = std::min(e[0], e[1]), b = std::max(e[0], e[1]);
+                size_t h = (static_cast<size_t>(a)*0x9e3779b97f4a7c15ull ^ static_cast<size_t>(b)) & mask;
+                while(std::get<2>(faces_m[h]) != none && (std::get<0>(faces_m[h]) != a || std::get<1>(faces_m[h]) != b)){
+                    h = (h + 1) & mask;
+                }
+                const Int f = std::get<2>(faces_m[h]);
+                if(f == none){
+                    faces_m[h] = {a, b, 4*s + j};
+                }else{
+                    link(s, j, f);
+                    matched++;
+                }
+            }
+            if(std::ranges::find(v, infinite_vertex) == std::end(v)){
+                res = s;
+            }
+        }
+        if(2*matched != 3*created_m.size()){
+            throw std::runtime_error("Insertion cavity is not a ball");
+        }
+        return res;
+    }
+
+    // The first four points that are not coplanar, positively oriented
+    std::optional<Tetrahedron> initial_tetrahedron(const std::vector<Int>& order) const
+    {
+        const size_t n = order.size();
+        auto collinear = [this](const Int a, const Int b, const Int c)
+        {
+            auto pa = vertices_m[a], pb = vertices_m[b], pc = vertices_m[c];
+            return orient2d(pa.x(), pa.y(), pb.x(), pb.y(), pc.x(), pc.y()) == 0
+                && orient2d(pa.y(), pa.z(), pb.y(), pb.z(), pc.y(), pc.z()) == 0
+                && orient2d(pa.z(), pa.x(), pb.z(), pb.x(), pc.z(), pc.x()) == 0;
+        };
+        const Int a = order[0];
+        size_t b = 1;
+        while(b < n && vertices_m[order[b]] == vertices_m[a]){
+            b++;
+        }
+        size_t c = b + 1;
+        while(c < n && collinear(a, order[b], order[c])){
+            c++;
+        }
+        size_t d = c + 1;
+        while(d < n && orientation(a, order[b], order[c], order[d]) == 0){
+            d++;
+        }
+        if(d >= n){
+            return {};
+        }
+        if(orientation(a, order[b], order[c], order[d]) < 0){
+            std::swap(b, c);
+        }
+        return Tetrahedron{a, order[b], order[c], order[d]};
+    }
+
+    // Drop the released slots and move the finite tetrahedra to the front,
+    // renumbering the links. Done in place, by following the cycles of the
+    // renumbering, to keep the peak memory down.
+    void compact()
+    {
+        const size_t n = tetrahedra_m.size();
+        std::vector<Int> new_index(n);
+        Int k = 0;
+        for(Int t = 0; t < n; t++){
+            if(in_cavity_m[t] != released && !is_ghost(t)){
+                new_index[t] = k++;
+            }
+        }
+        finite_m = k;
+        for(Int t = 0; t < n; t++){
+            if(in_cavity_m[t] != released && is_ghost(t)){
+                new_index[t] = k++;
+            }
+        }
+        for(Int t = 0; t < n; t++){
+            if(in_cavity_m[t] != released){
+                for(Int& l : neighbors_m[t]){
+                    l = 4*new_index[l/4] + l%4;
+                }
+            }
+        }
+        // in_cavity_m now tells slots still to be moved (0), free ones
+        // (released) and those already holding their final tetrahedron (1)
+        for(Int t = 0; t < n; t++){
+            if(in_cavity_m[t] != 0){
+                continue;
+            }
+            Tetrahedron v = tetrahedra_m[t], nb = neighbors_m[t];
+            Int d = new_index[t];
+            in_cavity_m[t] = released;
+            while(in_cavity_m[d] == 0){
+                const Int next = new_index[d];
+                std::swap(v, tetrahedra_m[d]);
+                std::swap(nb, neighbors_m[d]);
+                in_cavity_m[d] = 1;
+                d = next;
+            }
+            tetrahedra_m[d] = v;
+            neighbors_m[d] = nb;
+            in_cavity_m[d] = 1;
+        }
+        tetrahedra_m.resize(k);
+        neighbors_m.resize(k);
+    }
+
+    void tetrahedralize_vertices()
+    {
+        tetrahedra_m.clear();
+        neighbors_m.clear();
+        finite_m = 0;
+        const auto order = brio_order_3d<Int>(vertices_m);
+        if(order.size() < 4){
+            return;
+        }
+        auto initial = initial_tetrahedron(order);
+        if(!initial){
+            return;
+        }
+
+        // The initial tetrahedron and one ghost on each of its faces. The
+        // ghost on face i has vertex i made infinite and two of the others
+        // swapped, turning it inside out.
+        const auto v = *initial;
+        tetrahedra_m.reserve(7*order.size());
+        neighbors_m.reserve(7*order.size());
+        tetrahedra_m.push_back(v);
+        for(Int i = 0; i < 4; i++){
+            auto g = v;
+            g[i] = infinite_vertex;
+            std::swap(g[(i + 1) % 4], g[(i + 2) % 4]);
+            tetrahedra_m.push_back(g);
+        }
+        neighbors_m.resize(5);
+        for(Int i = 0; i < 4; i++){
+            link(0, i, 4*(i + 1) + i);
+            for(Int j = i + 1; j < 4; j++){
+                // Ghosts i and j share the face without v[i] and v[j]
+                const auto& gi = tetrahedra_m[i + 1];
+                const auto& gj = tetrahedra_m[j + 1];
+                const auto si = static_cast<Int>(std::ranges::find(gi, v[j]) - std::begin(gi));
+                const auto sj = static_cast<Int>(std::ranges::find(gj, v[i]) - std::begin(gj));
+                link(i + 1, si, 4*(j + 1) + sj);
+            }
+        }
+        in_cavity_m.assign(5, 0);
+        free_m.clear();
+
+        Int hint = 0;
+        for(const Int p : order){
+            if(std::ranges::find(v, p) == std::end(v)){
+                hint = insert(p, hint);
+            }
+        }
+        compact();
+        in_cavity_m = {};
+        cavity_m = {};
+        created_m = {};
+        faces_m = {};
+        free_m = {};
+    }
+
+public:
+    Tetrahedralization() = default;
+    Tetrahedralization(const Tetrahedralization&) = default;
+    Tetrahedralization(Tetrahedralization&&) = default;
+    ~Tetrahedralization() = default;
+
+    Tetrahedralization& operator=(const Tetrahedralization&) = default;
+    Tetrahedralization& operator=(Tetrahedralization&&) = default;
+
+    void tetrahedralize(const std::vector<Vertex<Float, 3>>& points)
+    {
+        vertices_m.assign(points);
+        tetrahedralize_vertices();
+    }
+
+    // Points given as interleaved coordinates, point i at coordinates[i*stride]
+    // to coordinates[i*stride + 2]. Throws std::invalid_argument if stride is
+    // less than 3, which would make the points overlap.
+    void tetrahedralize(std::span<const Float> coordinates, const size_t stride = 3)
+    {
+        if(stride < 3){
+            throw std::invalid_argument("Stride must be at least the 3 coordinates of a point");
+        }
+        const size_t n = coordinates.size() < 3 ? 0 : (coordinates.size() - 3)/stride + 1;
+        vertices_m.resize(n);
+        for(size_t i = 0; i < n; i++){
+            for(size_t d = 0; d < 3; d++){
+                vertices_m.coordinate(d, i) = coordinates[i*stride + d];
+            }
+        }
+        tetrahedralize_vertices();
+    }
+
+    std::vector<Vertex<Float, 3>> vertices() const
+    {
+        return vertices_m.to_vector();
+    }
+
+    // Coordinate d of every vertex
+    std::span<const Float> coordinates(const size_t d) const
+    {
+        return vertices_m.coordinates(d);
+    }
+
+    std::vector<Tetrahedron> tetrahedra() const
+    {
+        return {std::begin(tetrahedra_m), std::begin(tetrahedra_m) + finite_m};
+    }
+
+    // The finite tetrahedra in place
+    std::span<const Tetrahedron> tetrahedra_view() const
+    {
+        return std::span(tetrahedra_m).first(finite_m);
+    }
+
+    // Neighbor links of the finite tetrahedra, 4*t + j standing for slot j of
+    // tetrahedron t. Links to t >= tetrahedron_count() cross the convex hull.
+    std::span<const Tetrahedron> neighbors_view() const
+    {
+        return std::span(neighbors_m).first(finite_m);
+    }
+
+    // Neighbor of tetrahedron t opposite its vertex i, none across the hull
+    OptionalIndex<Int> neighbor(const Int t, const Int i) const
+    {
+        const Int n = neighbors_m[t][i]/4;
+        return n < finite_m ? OptionalIndex<Int>(n) : OptionalIndex<Int>();
+    }
+
+    size_t tetrahedron_count() const
+    {
+        return finite_m;
+    }
+};
+
+#endif // DELAUNAY_TETRAHEDRALIZATION_LIB_H
@@ -11,6 +11,26 @@
 #include <algorithm>
 #include <numeric>
 #include <initializer_list>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <bit>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <cstring>
+#include <new>
+#include <span>
+#include <ranges>
+#include <queue>
+#include <functional>
+#include <chrono>
+#include <string_view>
+#include <istream>
+#include <utility>
 
 template<typename T>
 concept Floating = std::is_floating_point_v<T>;
@@ -21,15 +41,21 @@ concept Integral = std::integral<T>;
 template<typename T>
 concept Numeric = std::integral<T> || std::floating_point<T>;
 
+template<typename P>
+concept PlanarPoint = requires(const P& p){
+    p.x();
+    p.y();
+};
+
 template<Numeric Float>
 class Edge;
-template<>
-class Edge<size_t>;
+template<Integral Int>
+class Edge<Int>;
 
 template<Numeric Float>
 class Triangle;
-template<>
-class Triangle<size_t>;
+template<Integral Int>
+class Triangle<Int>;
 
 
 
@@ -132,6 +158,21 @@ public:
     {
         return pos_m.back();
     }
+
+    Float x() const
+    {
+        return pos_m[0];
+    }
+
+    Float y() const requires(Dim >= 2)
+    {
+        return pos_m[1];
+    }
+
+    Float z() const requires(Dim >= 3)
+    {
+        return pos_m[2];
+    }
 };
 
 template<Numeric Float, size_t Dim = 2>
@@ -144,11 +185,755 @@ Float dist2(const Vertex<Float, Dim>& a, const Vertex<Float, Dim>& b)
             return (bi-ai)*(bi-ai);
         });
     Float res = 0;
-    std::accumulate(std::begin(diff), std::end(diff), res, std::plus());
+    return std::accumulate(std::begin(diff), std::end(diff), res, std::plus());
+
+}
+
+// Robust predicates after Shewchuk. A determinant is first evaluated in
+// floating point and its sign trusted if the value exceeds a bound on the
+// rounding error. Otherwise it is evaluated exactly as an expansion, a sum
+// of nonoverlapping floating point numbers ordered by increasing magnitude
+// whose sign is that of its last component.
+template<Floating Float>
+std::tuple<Float, Float> two_sum(const Float a, const Float b)
+{
+    Float x = a + b;
+    Float bv = x - a;
+    Float av = x - bv;
+    return {x, (a - av) + (b - bv)};
+}
+
+template<Floating Float>
+std::tuple<Float, Float> two_diff(const Float a, const Float b)
+{
+    Float x = a - b;
+    Float bv = a - x;
+    Float av = x + bv;
+    return {x, (a - av) + (bv - b)};
+}
+
+template<Floating Float>
+std::tuple<Float, Float> two_product(const Float a, const Float b)
+{
+    Float x = a*b;
+    return {x, std::fma(a, b, -x)};
+}
+
+// An expansion of at most N components, kept on the stack. The capacities
+// of sums and products follow Shewchuk's bounds on their lengths, so no
+// operation can overrun its buffer.
+template<Floating Float, size_t N>
+struct Expansion{
+    std::array<Float, N> components;
+    size_t length = 0;
+
+    Float* data() {return components.data();}
+    const Float* data() const {return components.data();}
+
+    // The last component, whose sign is that of the expansion
+    Float approximate() const {return length == 0 ? 0 : components[length - 1];}
+};
+
+template<Floating Float>
+Expansion<Float, 2> exact_diff(const Float a, const Float b)
+{
+    auto [x, y] = two_diff(a, b);
+    Expansion<Float, 2> res;
+    if(y != 0){
+        res.components[res.length++] = y;
+    }
+    if(x != 0){
+        res.components[res.length++] = x;
+    }
+    return res;
+}
+
+template<Floating Float>
+Expansion<Float, 2> exact_product(const Float a, const Float b)
+{
+    auto [x, y] = two_product(a, b);
+    Expansion<Float, 2> res;
+    if(y != 0){
+        res.components[res.length++] = y;
+    }
+    if(x != 0){
+        res.components[res.length++] = x;
+    }
+    return res;
+}
+
+// Sum of the expansions e and f of elen and flen components, written to h
+// which has room for elen + flen of them. Returns the length of the sum.
+template<Floating Float>
+size_t expansion_sum(const size_t elen, const Float* e, const size_t flen, const Float* f, Float* h)
+{
+    size_t i = 0, j = 0, hlen = 0;
+    auto next = [&]()
+    {
+        if(j == flen || (i < elen && std::abs(e[i]) < std::abs(f[j]))){
+            return e[i++];
+        }
+        return f[j++];
+    };
+    if(elen + flen == 0){
+        return 0;
+    }
+    Float q = next();
+    for(size_t k = 1; k < elen + flen; k++){
+        auto [x, y] = two_sum(q, next());
+        if(y != 0){
+            h[hlen++] = y;
+        }
+        q = x;
+    }
+    if(q != 0){
+        h[hlen++] = q;
+    }
+    return hlen;
+}
+
+// The expansion e of elen components scaled by b, written to h which has
+// room for 2*elen of them. Returns the length of the product.
+template<Floating Float>
+size_t scale_expansion(const size_t elen, const Float* e, const Float b, Float* h)
+{
+    if(elen == 0){
+        return 0;
+    }
+    size_t hlen = 0;
+    auto [q, hh] = two_product(e[0], b);
+    if(hh != 0){
+        h[hlen++] = hh;
+    }
+    for(size_t i = 1; i < elen; i++){
+        auto [p1, p0] = two_product(e[i], b);
+        auto [sum, h0] = two_sum(q, p0);
+        if(h0 != 0){
+            h[hlen++] = h0;
+        }
+        auto [q1, h1] = two_sum(p1, sum);
+        if(h1 != 0){
+            h[hlen++] = h1;
+        }
+        q = q1;
+    }
+    if(q != 0){
+        h[hlen++] = q;
+    }
+    return hlen;
+}
+
+template<Floating Float, size_t N, size_t M>
+Expansion<Float, N + M> expansion_sum(const Expansion<Float, N>& e, const Expansion<Float, M>& f)
+{
+    Expansion<Float, N + M> res;
+    res.length = expansion_sum(e.length, e.data(), f.length, f.data(), res.data());
+    return res;
+}
+
+template<Floating Float, size_t N, size_t M>
+Expansion<Float, N + M> expansion_diff(const Expansion<Float, N>& e, const Expansion<Float, M>& f)
+{
+    Expansion<Float, M> negated;
+    negated.length = f.length;
+    for(size_t i = 0; i < f.length; i++){
+        negated.components[i] = -f.components[i];
+    }
+    return expansion_sum(e, negated);
+}
+
+template<Floating Float, size_t N>
+Expansion<Float, 2*N> scale_expansion(const Expansion<Float, N>& e, const Float b)
+{
+    Expansion<Float, 2*N> res;
+    res.length = scale_expansion(e.length, e.data(), b, res.data());
+    return res;
+}
+
+// Sum of e scaled by every component of f. The partial sums alternate
+// between the result and a scratch buffer, so the last one lands in the
+// result.
+template<Floating Float, size_t N, size_t M>
+Expansion<Float, 2*N*M> expansion_product(const Expansion<Float, N>& e, const Expansion<Float, M>& f)
+{
+    Expansion<Float, 2*N*M> res;
+    std::array<Float, 2*N*M> scratch;
+    std::array<Float, 2*N> scaled;
+    size_t length = 0;
+    for(size_t i = 0; i < f.length; i++){
+        const bool last_in_res = (f.length - i)%2 == 1;
+        Float* from = last_in_res ? scratch.data() : res.data();
+        Float* to = last_in_res ? res.data() : scratch.data();
+        const size_t slen = scale_expansion(e.length, e.data(), f.components[i], scaled.data());
+        length = expansion_sum(length, from, slen, scaled.data(), to);
+    }
+    res.length = length;
+    return res;
+}
+
+// Positive if a, b and c are in counterclockwise order, negative if they are
+// in clockwise order and zero if they are collinear
+template<Numeric Float>
+Float orient2d(const Float ax, const Float ay, const Float bx, const Float by, const Float cx, const Float cy)
+{
+    const Float detleft = (ax - cx)*(by - cy);
+    const Float detright = (ay - cy)*(bx - cx);
+    const Float det = detleft - detright;
+    if constexpr(std::floating_point<Float>){
+        if(detleft == 0 || (detleft > 0 ? detright <= 0 : detright >= 0)){
+            return det;
+        }
+        constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+        constexpr Float bound = (3 + 16*eps)*eps;
+        if(std::abs(det) >= bound*(std::abs(detleft) + std::abs(detright))){
+            return det;
+        }
+        auto acx = exact_diff(ax, cx), acy = exact_diff(ay, cy);
+        auto bcx = exact_diff(bx, cx), bcy = exact_diff(by, cy);
+        auto exact = expansion_diff(expansion_product(acx, bcy), expansion_product(acy, bcx));
+        return exact.approximate();
+    }else{
+        return det;
+    }
+}
+
+// Positive if d lies inside the circle through a, b and c, in
+// counterclockwise order, negative if outside and zero if on the circle
+template<Numeric Float>
+Float incircle(const Float ax, const Float ay, const Float bx, const Float by,
+               const Float cx, const Float cy, const Float dx, const Float dy)
+{
+    const Float adx = ax - dx, ady = ay - dy;
+    const Float bdx = bx - dx, bdy = by - dy;
+    const Float cdx = cx - dx, cdy = cy - dy;
+    const Float bdxcdy = bdx*cdy, cdxbdy = cdx*bdy;
+    const Float cdxady = cdx*ady, adxcdy = adx*cdy;
+    const Float adxbdy = adx*bdy, bdxady = bdx*ady;
+    const Float alift = adx*adx + ady*ady;
+    const Float blift = bdx*bdx + bdy*bdy;
+    const Float clift = cdx*cdx + cdy*cdy;
+    const Float det = alift*(bdxcdy - cdxbdy) + blift*(cdxady - adxcdy) + clift*(adxbdy - bdxady);
+    if constexpr(std::floating_point<Float>){
+        constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+        constexpr Float bound = (10 + 96*eps)*eps;
+        const Float permanent = (std::abs(bdxcdy) + std::abs(cdxbdy))*alift
+                              + (std::abs(cdxady) + std::abs(adxcdy))*blift
+                              + (std::abs(adxbdy) + std::abs(bdxady))*clift;
+        if(std::abs(det) > bound*permanent){
+            return det;
+        }
+        auto ex = exact_diff(ax, dx), ey = exact_diff(ay, dy);
+        auto fx = exact_diff(bx, dx), fy = exact_diff(by, dy);
+        auto gx = exact_diff(cx, dx), gy = exact_diff(cy, dy);
+        auto lift = [](const auto& x, const auto& y) {
+            return expansion_sum(expansion_product(x, x), expansion_product(y, y));
+        };
+        auto cross = [](const auto& x0, const auto& y0, const auto& x1, const auto& y1) {
+            return expansion_diff(expansion_product(x0, y1), expansion_product(x1, y0));
+        };
+        auto exact = expansion_sum(
+            expansion_sum(expansion_product(lift(ex, ey), cross(fx, fy, gx, gy)),
+                          expansion_product(lift(fx, fy), cross(gx, gy, ex, ey))),
+            expansion_product(lift(gx, gy), cross(ex, ey, fx, fy)));
+        return exact.approximate();
+    }else{
+        return det;
+    }
+}
+
+// Positive if d lies below the plane through a, b and c, below meaning that
+// a, b and c appear in counterclockwise order seen from above. Negative if d
+// lies above the plane and zero if the four points are coplanar.
+template<Numeric Float>
+Float orient3d(const Float ax, const Float ay, const Float az, const Float bx, const Float by, const Float bz,
+               const Float cx, const Float cy, const Float cz, const Float dx, const Float dy, const Float dz)
+{
+    const Float adx = ax - dx, ady = ay - dy, adz = az - dz;
+    const Float bdx = bx - dx, bdy = by - dy, bdz = bz - dz;
+    const Float cdx = cx - dx, cdy = cy - dy, cdz = cz - dz;
+    const Float bdxcdy = bdx*cdy, cdxbdy = cdx*bdy;
+    const Float cdxady = cdx*ady, adxcdy = adx*cdy;
+    const Float adxbdy = adx*bdy, bdxady = bdx*ady;
+    const Float det = adz*(bdxcdy - cdxbdy) + bdz*(cdxady - adxcdy) + cdz*(adxbdy - bdxady);
+    if constexpr(std::floating_point<Float>){
+        constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+        constexpr Float bound = (7 + 56*eps)*eps;
+        const Float permanent = (std::abs(bdxcdy) + std::abs(cdxbdy))*std::abs(adz)
+                              + (std::abs(cdxady) + std::abs(adxcdy))*std::abs(bdz)
+                              + (std::abs(adxbdy) + std::abs(bdxady))*std::abs(cdz);
+        if(std::abs(det) > bound*permanent){
+            return det;
+        }
+        auto ex = exact_diff(ax, dx), ey = exact_diff(ay, dy), ez = exact_diff(az, dz);
+        auto fx = exact_diff(bx, dx), fy = exact_diff(by, dy), fz = exact_diff(bz, dz);
+        auto gx = exact_diff(cx, dx), gy = exact_diff(cy, dy), gz = exact_diff(cz, dz);
+        auto cross = [](const auto& x0, const auto& y0, const auto& x1, const auto& y1) {
+            return expansion_diff(expansion_product(x0, y1), expansion_product(x1, y0));
+        };
+        auto exact = expansion_sum(
+            expansion_sum(expansion_product(cross(fx, fy, gx, gy), ez),
+                          expansion_product(cross(gx, gy, ex, ey), fz)),
+            expansion_product(cross(ex, ey, fx, fy), gz));
+        return exact.approximate();
+    }else{
+        return det;
+    }
+}
+
+// Positive if e lies inside the sphere through a, b, c and d, which have to
+// be ordered so that orient3d(a, b, c, d) is positive. Negative if outside
+// and zero if on the sphere.
+template<Numeric Float>
+Float insphere(const Float ax, const Float ay, const Float az, const Float bx, const Float by, const Float bz,
+               const Float cx, const Float cy, const Float cz, const Float dx, const Float dy, const Float dz,
+               const Float ex, const Float ey, const Float ez)
+{
+    const Float aex = ax - ex, aey = ay - ey, aez = az - ez;
+    const Float bex = bx - ex, bey = by - ey, bez = bz - ez;
+    const Float cex = cx - ex, cey = cy - ey, cez = cz - ez;
+    const Float dex = dx - ex, dey = dy - ey, dez = dz - ez;
+    const Float aexbey = aex*bey, bexaey = bex*aey;
+    const Float bexcey = bex*cey, cexbey = cex*bey;
+    const Float cexdey = cex*dey, dexcey = dex*cey;
+    const Float dexaey = dex*aey, aexdey = aex*dey;
+    const Float aexcey = aex*cey, cexaey = cex*aey;
+    const Float bexdey = bex*dey, dexbey = dex*bey;
+    const Float ab = aexbey - bexaey, bc = bexcey - cexbey;
+    const Float cd = cexdey - dexcey, da = dexaey - aexdey;
+    const Float ac = aexcey - cexaey, bd = bexdey - dexbey;
+    const Float abc = aez*bc - bez*ac + cez*ab;
+    const Float bcd = bez*cd - cez*bd + dez*bc;
+    const Float cda = cez*da + dez*ac + aez*cd;
+    const Float dab = dez*ab + aez*bd + bez*da;
+    const Float alift = aex*aex + aey*aey + aez*aez;
+    const Float blift = bex*bex + bey*bey + bez*bez;
+    const Float clift = cex*cex + cey*cey + cez*cez;
+    const Float dlift = dex*dex + dey*dey + dez*dez;
+    const Float det = (dlift*abc - clift*dab) + (blift*cda - alift*bcd);
+    if constexpr(std::floating_point<Float>){
+        constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+        constexpr Float bound = (16 + 224*eps)*eps;
+        const Float abs_aez = std::abs(aez), abs_bez = std::abs(bez), abs_cez = std::abs(cez), abs_dez = std::abs(dez);
+        const Float abs_ab = std::abs(aexbey) + std::abs(bexaey), abs_bc = std::abs(bexcey) + std::abs(cexbey);
+        const Float abs_cd = std::abs(cexdey) + std::abs(dexcey), abs_da = std::abs(dexaey) + std::abs(aexdey);
+        const Float abs_ac = std::abs(aexcey) + std::abs(cexaey), abs_bd = std::abs(bexdey) + std::abs(dexbey);
+        const Float permanent = (abs_cd*abs_bez + abs_bd*abs_cez + abs_bc*abs_dez)*alift
+                              + (abs_da*abs_cez + abs_ac*abs_dez + abs_cd*abs_aez)*blift
+                              + (abs_ab*abs_dez + abs_bd*abs_aez + abs_da*abs_bez)*clift
+                              + (abs_bc*abs_aez + abs_ac*abs_bez + abs_ab*abs_cez)*dlift;
+        if(std::abs(det) > bound*permanent){
+            return det;
+        }
+        // The differences to e would be expansions of two components and
+        // make the products too long for the stack. As in Shewchuk's
+        // insphereexact, the determinant is instead expanded on the input
+        // coordinates as the 5x5 one with rows (x, y, z, x^2 + y^2 + z^2, 1),
+        // which has the same value.
+        const std::array<Float, 5> x{ax, bx, cx, dx, ex}, y{ay, by, cy, dy, ey}, z{az, bz, cz, dz, ez};
+        auto minor2 = [&](const size_t p, const size_t q) {
+            return expansion_diff(exact_product(x[p], y[q]), exact_product(x[q], y[p]));
+        };
+        // Rows (x, y, 1)
+        auto minor3 = [&](const size_t p, const size_t q, const size_t r) {
+            return expansion_sum(expansion_sum(minor2(p, q), minor2(q, r)), minor2(r, p));
+        };
+        // Rows (x, y, z, 1)
+        auto minor4 = [&](const size_t p, const size_t q, const size_t r, const size_t s) {
+            return expansion_sum(expansion_diff(scale_expansion(minor3(q, r, s), z[p]), scale_expansion(minor3(p, r, s), z[q])),
+                                 expansion_diff(scale_expansion(minor3(p, q, s), z[r]), scale_expansion(minor3(p, q, r), z[s])));
+        };
+        auto lift = [&](const size_t p) {
+            return expansion_sum(expansion_sum(exact_product(x[p], x[p]), exact_product(y[p], y[p])), exact_product(z[p], z[p]));
+        };
+        auto exact = expansion_diff(
+            expansion_sum(expansion_diff(expansion_product(minor4(0, 2, 3, 4), lift(1)), expansion_product(minor4(1, 2, 3, 4), lift(0))),
+                          expansion_diff(expansion_product(minor4(0, 1, 2, 4), lift(3)), expansion_product(minor4(0, 1, 3, 4), lift(2)))),
+            expansion_product(minor4(0, 1, 2, 3), lift(4)));
+        return exact.approximate();
+    }else{
+        return det;
+    }
+}
+
+// Center of the circle through a, b and c, computed relative to a
+template<Numeric Float>
+std::array<Float, 2> circumcenter(const Float ax, const Float ay, const Float bx, const Float by, const Float cx, const Float cy)
+{
+    Float dx = bx - ax, dy = by - ay;
+    Float ex = cx - ax, ey = cy - ay;
+    Float bl = dx*dx + dy*dy, cl = ex*ex + ey*ey;
+    Float d = 2*(dx*ey - dy*ex);
+    return {ax + (ey*bl - dy*cl)/d, ay + (dx*cl - ex*bl)/d};
+}
+
+// Points read lane by lane by the batched predicates: lane i uses
+// (x[i*step], y[i*step]), so step is 2 for an array of vertices, 1 for
+// separate coordinate arrays and 0 to use the same point in every lane.
+template<Floating Float>
+struct BatchPoints{
+    const Float* x;
+    const Float* y;
+    size_t step = 1;
+
+    BatchPoints(const Float* xs, const Float* ys, const size_t stride = 1)
+     : x(xs), y(ys), step(stride)
+    {}
+
+    BatchPoints(const Vertex<Float>* v, const size_t stride = 1)
+     : x(&*v->begin()), y(&*v->begin() + 1), step(2*stride)
+    {
+        static_assert(sizeof(Vertex<Float>) == 2*sizeof(Float));
+    }
+
+    Float x_at(const size_t i) const
+    {
+        return x[i*step];
+    }
+
+    Float y_at(const size_t i) const
+    {
+        return y[i*step];
+    }
+};
+
+enum class Simd{scalar, avx2, avx512};
+
+#if !defined(DELAUNAY_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DELAUNAY_SIMD_X86
+#endif
+
+// Widest instruction set the batched predicates can use on this CPU
+inline Simd simd_support()
+{
+#ifdef DELAUNAY_SIMD_X86
+    static const Simd res = __builtin_cpu_supports("avx512f") ? Simd::avx512
+                          : __builtin_cpu_supports("avx2") ? Simd::avx2 : Simd::scalar;
     return res;
+#else
+    return Simd::scalar;
+#endif
+}
+
+#ifdef DELAUNAY_SIMD_X86
+// The kernels are written with vector extensions and compiled once per
+// instruction set. A lane whose filtered value is not trusted is recomputed
+// by the scalar predicate.
+template<class V, Floating Float>
+[[gnu::always_inline]] inline void batch_load(V& res, const Float* p, const size_t step, const size_t i)
+{
+    constexpr size_t width = sizeof(V)/sizeof(Float);
+    if(step == 1){
+        std::memcpy(&res, p + i, sizeof(V));
+    }else if(step == 0){
+        const Float v = *p;
+        for(size_t l = 0; l < width; l++){
+            res[l] = v;
+        }
+    }else{
+        for(size_t l = 0; l < width; l++){
+            res[l] = p[(i + l)*step];
+        }
+    }
+}
+
+// |v| in place, vectors are not passed by value to stay clear of ABI
+// differences between instruction sets
+template<class V>
+[[gnu::always_inline]] inline void batch_abs(V& v)
+{
+    v = v < 0 ? -v : v;
+}
+
+template<Floating Float, size_t Bytes>
+[[gnu::always_inline]] inline void orient2d_kernel(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* res)
+{
+    using V [[gnu::vector_size(Bytes)]] = Float;
+    constexpr size_t width = Bytes/sizeof(Float);
+    constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+    constexpr Float bound = (3 + 16*eps)*eps;
+    size_t i = 0;
+    for(; i + width <= n; i += width){
+        V ax, ay, bx, by, cx, cy;
+        batch_load(ax, a.x, a.step, i);
+        batch_load(ay, a.y, a.step, i);
+        batch_load(bx, b.x, b.step, i);
+        batch_load(by, b.y, b.step, i);
+        batch_load(cx, c.x, c.step, i);
+        batch_load(cy, c.y, c.step, i);
+        V detleft = (ax - cx)*(by - cy);
+        V detright = (ay - cy)*(bx - cx);
+        V det = detleft - detright;
+        std::memcpy(res + i, &det, sizeof(V));
+        batch_abs(det);
+        batch_abs(detleft);
+        batch_abs(detright);
+        auto trusted = det >= bound*(detleft + detright);
+        for(size_t l = 0; l < width; l++){
+            if(!trusted[l]){
+                res[i + l] = orient2d(a.x_at(i + l), a.y_at(i + l), b.x_at(i + l), b.y_at(i + l), c.x_at(i + l), c.y_at(i + l));
+            }
+        }
+    }
+    for(; i < n; i++){
+        res[i] = orient2d(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i));
+    }
+}
+
+template<Floating Float, size_t Bytes>
+[[gnu::always_inline]] inline void incircle_kernel(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const BatchPoints<Float>& d, const size_t n, Float* res)
+{
+    using V [[gnu::vector_size(Bytes)]] = Float;
+    constexpr size_t width = Bytes/sizeof(Float);
+    constexpr Float eps = std::numeric_limits<Float>::epsilon()/2;
+    constexpr Float bound = (10 + 96*eps)*eps;
+    size_t i = 0;
+    for(; i + width <= n; i += width){
+        V ax, ay, bx, by, cx, cy, dx, dy;
+        batch_load(ax, a.x, a.step, i);
+        batch_load(ay, a.y, a.step, i);
+        batch_load(bx, b.x, b.step, i);
+        batch_load(by, b.y, b.step, i);
+        batch_load(cx, c.x, c.step, i);
+        batch_load(cy, c.y, c.step, i);
+        batch_load(dx, d.x, d.step, i);
+        batch_load(dy, d.y, d.step, i);
+        V adx = ax - dx, ady = ay - dy;
+        V bdx = bx - dx, bdy = by - dy;
+        V cdx = cx - dx, cdy = cy - dy;
+        V bdxcdy = bdx*cdy, cdxbdy = cdx*bdy;
+        V cdxady = cdx*ady, adxcdy = adx*cdy;
+        V adxbdy = adx*bdy, bdxady = bdx*ady;
+        V alift = adx*adx + ady*ady;
+        V blift = bdx*bdx + bdy*bdy;
+        V clift = cdx*cdx + cdy*cdy;
+        V det = alift*(bdxcdy - cdxbdy) + blift*(cdxady - adxcdy) + clift*(adxbdy - bdxady);
+        std::memcpy(res + i, &det, sizeof(V));
+        batch_abs(det);
+        batch_abs(bdxcdy);
+        batch_abs(cdxbdy);
+        batch_abs(cdxady);
+        batch_abs(adxcdy);
+        batch_abs(adxbdy);
+        batch_abs(bdxady);
+        V permanent = (bdxcdy + cdxbdy)*alift + (cdxady + adxcdy)*blift + (adxbdy + bdxady)*clift;
+        auto trusted = det > bound*permanent;
+        for(size_t l = 0; l < width; l++){
+            if(!trusted[l]){
+                res[i + l] = incircle(a.x_at(i + l), a.y_at(i + l), b.x_at(i + l), b.y_at(i + l),
+                                      c.x_at(i + l), c.y_at(i + l), d.x_at(i + l), d.y_at(i + l));
+            }
+        }
+    }
+    for(; i < n; i++){
+        res[i] = incircle(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i), d.x_at(i), d.y_at(i));
+    }
+}
+
+template<Floating Float, size_t Bytes>
+[[gnu::always_inline]] inline void circumcenter_kernel(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* x, Float* y)
+{
+    using V [[gnu::vector_size(Bytes)]] = Float;
+    constexpr size_t width = Bytes/sizeof(Float);
+    size_t i = 0;
+    for(; i + width <= n; i += width){
+        V ax, ay, bx, by, cx, cy;
+        batch_load(ax, a.x, a.step, i);
+        batch_load(ay, a.y, a.step, i);
+        batch_load(bx, b.x, b.step, i);
+        batch_load(by, b.y, b.step, i);
+        batch_load(cx, c.x, c.step, i);
+        batch_load(cy, c.y, c.step, i);
+        V dx = bx - ax, dy = by - ay;
+        V ex = cx - ax, ey = cy - ay;
+        V bl = dx*dx + dy*dy, cl = ex*ex + ey*ey;
+        V d = 2*(dx*ey - dy*ex);
+        V ox = ax + (ey*bl - dy*cl)/d;
+        V oy = ay + (dx*cl - ex*bl)/d;
+        std::memcpy(x + i, &ox, sizeof(V));
+        std::memcpy(y + i, &oy, sizeof(V));
+    }
+    for(; i < n; i++){
+        auto [ox, oy] = circumcenter(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i));
+        x[i] = ox;
+        y[i] = oy;
+    }
+}
+
+template<Floating Float>
+[[gnu::target("avx2")]] void orient2d_batch_avx2(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* res)
+{
+    orient2d_kernel<Float, 32>(a, b, c, n, res);
+}
+
+template<Floating Float>
+[[gnu::target("avx512f")]] void orient2d_batch_avx512(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* res)
+{
+    orient2d_kernel<Float, 64>(a, b, c, n, res);
+}
+
+template<Floating Float>
+[[gnu::target("avx2")]] void incircle_batch_avx2(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const BatchPoints<Float>& d, const size_t n, Float* res)
+{
+    incircle_kernel<Float, 32>(a, b, c, d, n, res);
+}
+
+template<Floating Float>
+[[gnu::target("avx512f")]] void incircle_batch_avx512(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const BatchPoints<Float>& d, const size_t n, Float* res)
+{
+    incircle_kernel<Float, 64>(a, b, c, d, n, res);
+}
 
+template<Floating Float>
+[[gnu::target("avx2")]] void circumcenter_batch_avx2(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* x, Float* y)
+{
+    circumcenter_kernel<Float, 32>(a, b, c, n, x, y);
+}
+
+template<Floating Float>
+[[gnu::target("avx512f")]] void circumcenter_batch_avx512(const BatchPoints<Float>& a, const BatchPoints<Float>& b,
+    const BatchPoints<Float>& c, const size_t n, Float* x, Float* y)
+{
+    circumcenter_kernel<Float, 64>(a, b, c, n, x, y);
+}
+#endif
+
+// res[i] = orient2d(a_i, b_i, c_i) for i < n, on the widest instruction set
+// available. Only single and double precision are vectorized.
+template<Floating Float>
+void orient2d_batch(const BatchPoints<Float>& a, const BatchPoints<Float>& b, const BatchPoints<Float>& c,
+    const size_t n, Float* res)
+{
+#ifdef DELAUNAY_SIMD_X86
+    if constexpr(std::is_same_v<Float, float> || std::is_same_v<Float, double>){
+        switch(simd_support()){
+            case Simd::avx512:
+                return orient2d_batch_avx512(a, b, c, n, res);
+            case Simd::avx2:
+                return orient2d_batch_avx2(a, b, c, n, res);
+            case Simd::scalar:
+                break;
+        }
+    }
+#endif
+    for(size_t i = 0; i < n; i++){
+        res[i] = orient2d(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i));
+    }
+}
+
+// res[i] = incircle(a_i, b_i, c_i, d_i) for i < n
+template<Floating Float>
+void incircle_batch(const BatchPoints<Float>& a, const BatchPoints<Float>& b, const BatchPoints<Float>& c,
+    const BatchPoints<Float>& d, const size_t n, Float* res)
+{
+#ifdef DELAUNAY_SIMD_X86
+    if constexpr(std::is_same_v<Float, float> || std::is_same_v<Float, double>){
+        switch(simd_support()){
+            case Simd::avx512:
+                return incircle_batch_avx512(a, b, c, d, n, res);
+            case Simd::avx2:
+                return incircle_batch_avx2(a, b, c, d, n, res);
+            case Simd::scalar:
+                break;
+        }
+    }
+#endif
+    for(size_t i = 0; i < n; i++){
+        res[i] = incircle(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i), d.x_at(i), d.y_at(i));
+    }
 }
 
+// (x[i], y[i]) = circumcenter(a_i, b_i, c_i) for i < n
+template<Floating Float>
+void circumcenter_batch(const BatchPoints<Float>& a, const BatchPoints<Float>& b, const BatchPoints<Float>& c,
+    const size_t n, Float* x, Float* y)
+{
+#ifdef DELAUNAY_SIMD_X86
+    if constexpr(std::is_same_v<Float, float> || std::is_same_v<Float, double>){
+        switch(simd_support()){
+            case Simd::avx512:
+                return circumcenter_batch_avx512(a, b, c, n, x, y);
+            case Simd::avx2:
+                return circumcenter_batch_avx2(a, b, c, n, x, y);
+            case Simd::scalar:
+                break;
+        }
+    }
+#endif
+    for(size_t i = 0; i < n; i++){
+        auto [ox, oy] = circumcenter(a.x_at(i), a.y_at(i), b.x_at(i), b.y_at(i), c.x_at(i), c.y_at(i));
+        x[i] = ox;
+        y[i] = oy;
+    }
+}
+
+// An index that may be absent, stored in the index type itself with its
+// largest value meaning none
+template<Integral Int>
+class OptionalIndex{
+public:
+    static constexpr Int none = std::numeric_limits<Int>::max();
+private:
+    Int i_m = none;
+public:
+    constexpr OptionalIndex() = default;
+    constexpr OptionalIndex(const Int i)
+     : i_m(i)
+    {}
+    constexpr OptionalIndex(std::nullopt_t)
+    {}
+    constexpr OptionalIndex(const std::optional<Int>& i)
+     : i_m(i ? *i : none)
+    {}
+
+    constexpr bool has_value() const
+    {
+        return i_m != none;
+    }
+
+    constexpr explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    constexpr Int operator*() const
+    {
+        return i_m;
+    }
+
+    constexpr Int value() const
+    {
+        if(!has_value()){
+            throw std::bad_optional_access();
+        }
+        return i_m;
+    }
+
+    constexpr Int value_or(const Int i) const
+    {
+        return has_value() ? i_m : i;
+    }
+
+    constexpr void reset()
+    {
+        i_m = none;
+    }
+
+    constexpr operator std::optional<Int>() const
+    {
+        return has_value() ? std::optional<Int>(i_m) : std::nullopt;
+    }
+
+    constexpr bool operator==(const OptionalIndex&) const = default;
+};
+
 template<Numeric Float>
 class Edge{
 private:
@@ -181,7 +966,7 @@ public:
     }
     std::string to_string() const
     {
-        return "{" + vertices_m[0].to_string() + " <-> " + vertices_m[1].t_string() + "}";
+        return "{" + vertices_m[0].to_string() + " <-> " + vertices_m[1].to_string() + "}";
     }
     friend std::ostream& operator<<(std::ostream& os, const Edge& a)
     {
@@ -243,12 +1028,13 @@ public:
     }
 };
 
-template<>
-class Edge<size_t>{
-   using Int = size_t;
+template<Integral Int>
+class Edge<Int>{
 private:
     std::array<Int, 2> vertex_indices_m;
-    std::array<Int, 2> neighbors_m;
+    // The triangles to the left and to the right of the edge from the
+    // first vertex to the second
+    std::array<OptionalIndex<Int>, 2> neighbors_m;
 public:
     Edge() = default;
     Edge(const Edge&) = default;
@@ -259,6 +1045,10 @@ public:
      : vertex_indices_m{a, b}, neighbors_m()
     {}
 
+    Edge(const Int& a, const Int& b, const OptionalIndex<Int> left, const OptionalIndex<Int> right)
+     : vertex_indices_m{a, b}, neighbors_m{left, right}
+    {}
+
     Edge(std::initializer_list<Int> l)
      :  vertex_indices_m(), neighbors_m()
     {
@@ -295,6 +1085,11 @@ public:
         return vertex_indices_m;
     }
 
+    auto& neighbors() const
+    {
+        return neighbors_m;
+    }
+
     auto begin()
     {
         return vertex_indices_m.begin();
@@ -448,12 +1243,12 @@ public:
     }
 };
 
-template<>
-class Triangle<size_t>{
-    using Int = size_t;
+// Triangle of vertex indices. The neighbor opposite vertex i is neighbors()[i].
+template<Integral Int>
+class Triangle<Int>{
 private:
     std::array<Int, 3> vertex_indices_m;
-    std::array<std::optional<Int>, 3> neighbors_m;
+    std::array<OptionalIndex<Int>, 3> neighbors_m;
 public:
     Triangle() = default;
     Triangle(const Triangle&) = default;
@@ -508,7 +1303,7 @@ public:
 
     void cycle(Int step = 1)
     {
-        Int n = step % vertex_indices_m.size();
+        const auto n = static_cast<std::ptrdiff_t>(step % vertex_indices_m.size());
         std::rotate(vertex_indices_m.begin(), vertex_indices_m.begin() + n, vertex_indices_m.end());
         std::rotate(neighbors_m.begin(), neighbors_m.begin() + n, neighbors_m.end());
     }
@@ -592,6 +1387,11 @@ public:
 
 };
 
+// Three vertex indices and three neighbor indices, the missing neighbor
+// being a sentinel rather than a flag
+static_assert(sizeof(Triangle<uint32_t>) == 24);
+static_assert(sizeof(Triangle<uint64_t>) == 48);
+
 template<Numeric Float>
 class Circle{
 private:
@@ -608,285 +1408,4022 @@ public:
 
     Circle(const Vertex<Float>& a, const Vertex<Float>& b, const Vertex<Float>& c)
      : center_m(), r2_m()
-    {}
-
-    bool contains(const Vertex<Float>& p)
     {
-        return dist2(p, center_m) < r2_m;
+        auto [x, y] = circumcenter(a.x(), a.y(), b.x(), b.y(), c.x(), c.y());
+        center_m = Vertex<Float>{x, y};
+        r2_m = dist2(a, center_m);
     }
-};
-
-template<Numeric Float, Integral Int>
-class Delaunay{
-private:
-    std::vector<Vertex<Float>> vertices_m;
-    std::vector<Edge<Int>> edges_m;
-    std::vector<Triangle<Int>> triangles_m;
-public:
-    Delaunay() = default;
-    Delaunay(const Delaunay&) = default;
-    Delaunay(Delaunay&&) = default;
-
-    ~Delaunay() = default;
-
-    Delaunay& operator=(const Delaunay&) = default;
-    Delaunay& operator=(Delaunay&&) = default;
 
-    std::vector<Vertex<Float>> vertices() const
+    const Vertex<Float>& center() const
     {
-        return vertices_m;
+        return center_m;
     }
 
-    std::vector<Edge<Int>> edges() const
+    Float radius2() const
     {
-        return edges_m;
+        return r2_m;
     }
 
-    std::vector<Triangle<size_t>> triangles() const
+    bool contains(const Vertex<Float>& p)
     {
-        return triangles_m;
+        return dist2(p, center_m) < r2_m;
     }
+};
 
-    std::vector<Edge<Float>> edges_coord() const
-    {
-        std::vector<Edge<Float>> res;
-        std::transform(std::begin(this->edges_m), std::end(this->edges_m), std::begin(res),
-            [&] (const Edge<Int>& vertex_indices)
-            {
-                return Edge<Float>{vertices_m[vertex_indices[0]], vertices_m[vertex_indices[1]]};
-            }
-        );
-        return res;
+// Split [0, n) into one contiguous chunk per thread and run
+// f(chunk, begin, end) for every chunk, each on its own thread
+template<class Function>
+void parallel_chunks(const unsigned threads, const size_t n, Function&& f)
+{
+    if(threads <= 1){
+        f(0u, size_t(0), n);
+        return;
+    }
+    std::vector<std::jthread> workers;
+    for(unsigned i = 1; i < threads; i++){
+        workers.emplace_back(f, i, i*n/threads, (i + 1)*n/threads);
+    }
+    f(0u, size_t(0), n/threads);
+}
+
+// Index of (x, y) along the Hilbert curve filling the 2^16 x 2^16 grid
+inline uint32_t hilbert_index(uint32_t x, uint32_t y)
+{
+    constexpr uint32_t n = 1u << 16;
+    uint32_t d = 0;
+    for(uint32_t s = n/2; s > 0; s /= 2){
+        uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += s*s*((3*rx) ^ ry);
+        if(ry == 0){
+            if(rx == 1){
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// LSD radix sort of values by keys, one byte at a time. Passes where every
+// key has the same byte are skipped.
+template<Integral Int>
+void radix_sort(std::vector<uint64_t>& keys, std::vector<Int>& values)
+{
+    std::vector<uint64_t> keys_tmp(keys.size());
+    std::vector<Int> values_tmp(values.size());
+    for(unsigned shift = 0; shift < 64; shift += 8){
+        std::array<size_t, 257> offsets{};
+        for(auto k : keys){
+            offsets[((k >> shift) & 0xff) + 1]++;
+        }
+        if(std::ranges::find(offsets, keys.size()) != std::end(offsets)){
+            continue;
+        }
+        std::partial_sum(std::begin(offsets), std::end(offsets), std::begin(offsets));
+        for(size_t i = 0; i < keys.size(); i++){
+            size_t j = offsets[(keys[i] >> shift) & 0xff]++;
+            keys_tmp[j] = keys[i];
+            values_tmp[j] = values[i];
+        }
+        std::swap(keys, keys_tmp);
+        std::swap(values, values_tmp);
+    }
+}
+
+// Index of (x, y, z) along the Morton curve filling the 2^16 x 2^16 x 2^16
+// grid
+inline uint64_t morton_index(uint32_t x, uint32_t y, uint32_t z)
+{
+    auto spread = [](uint64_t v)
+    {
+        v = (v | v << 32) & 0x1f00000000ffffull;
+        v = (v | v << 16) & 0x1f0000ff0000ffull;
+        v = (v | v << 8) & 0x100f00f00f00f00full;
+        v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+        v = (v | v << 2) & 0x1249249249249249ull;
+        return v;
+    };
+    return spread(x) | spread(y) << 1 | spread(z) << 2;
+}
+
+// Biased randomized insertion order. Each point is put in a round, the last
+// round holding about half of the points, the one before it a quarter, and
+// so on. Rounds are inserted in order, and the points of each round are
+// sorted by their position along a space filling curve, given in curve.
+template<Integral Int>
+std::vector<Int> brio_sort(std::vector<uint64_t> curve)
+{
+    std::vector<Int> order(curve.size());
+    std::iota(std::begin(order), std::end(order), Int(0));
+    auto rounds = static_cast<unsigned>(std::max(std::bit_width(curve.size()), size_t(7)) - 7);
+    std::minstd_rand rng;
+    for(auto& key : curve){
+        auto level = static_cast<unsigned>(std::countr_zero(static_cast<uint32_t>(rng()) | (1u << rounds)));
+        key |= static_cast<uint64_t>(rounds - level) << 48;
+    }
+    radix_sort(curve, order);
+    return order;
+}
+
+// Position of every point along a Hilbert curve over their bounding square
+template<class Points>
+std::vector<uint64_t> hilbert_keys(const Points& points)
+{
+    if(points.size() == 0){
+        return {};
+    }
+    double xmin = points[0].x(), xmax = xmin, ymin = points[0].y(), ymax = ymin;
+    for(size_t i = 1; i < points.size(); i++){
+        xmin = std::min<double>(xmin, points[i].x());
+        xmax = std::max<double>(xmax, points[i].x());
+        ymin = std::min<double>(ymin, points[i].y());
+        ymax = std::max<double>(ymax, points[i].y());
+    }
+    double extent = std::max(xmax - xmin, ymax - ymin);
+    double scale = extent > 0 ? 65535/extent : 0;
+
+    std::vector<uint64_t> curve(points.size());
+    for(size_t i = 0; i < points.size(); i++){
+        auto x = static_cast<uint32_t>((static_cast<double>(points[i].x()) - xmin)*scale);
+        auto y = static_cast<uint32_t>((static_cast<double>(points[i].y()) - ymin)*scale);
+        curve[i] = hilbert_index(x, y);
+    }
+    return curve;
+}
+
+// BRIO of points in the plane, along a Hilbert curve
+template<Integral Int, class Points>
+std::vector<Int> brio_order(const Points& points)
+{
+    return brio_sort<Int>(hilbert_keys(points));
+}
+
+// Points sorted along a Hilbert curve
+template<Integral Int, class Points>
+std::vector<Int> hilbert_order(const Points& points)
+{
+    auto curve = hilbert_keys(points);
+    std::vector<Int> order(curve.size());
+    std::iota(std::begin(order), std::end(order), Int(0));
+    radix_sort(curve, order);
+    return order;
+}
+
+// BRIO of points in space, along a Morton curve
+template<Integral Int, class Points>
+std::vector<Int> brio_order_3d(const Points& points)
+{
+    if(points.size() == 0){
+        return {};
+    }
+    std::array<double, 3> lo{points[0].x(), points[0].y(), points[0].z()}, hi = lo;
+    for(size_t i = 1; i < points.size(); i++){
+        const std::array<double, 3> p{points[i].x(), points[i].y(), points[i].z()};
+        for(size_t d = 0; d < 3; d++){
+            lo[d] = std::min(lo[d], p[d]);
+            hi[d] = std::max(hi[d], p[d]);
+        }
+    }
+    double extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+    double scale = extent > 0 ? 65535/extent : 0;
+
+    std::vector<uint64_t> curve(points.size());
+    for(size_t i = 0; i < points.size(); i++){
+        auto x = static_cast<uint32_t>((points[i].x() - lo[0])*scale);
+        auto y = static_cast<uint32_t>((points[i].y() - lo[1])*scale);
+        auto z = static_cast<uint32_t>((points[i].z() - lo[2])*scale);
+        curve[i] = morton_index(x, y, z);
+    }
+    return brio_sort<Int>(std::move(curve));
+}
+
+// Allocator for arrays starting on a cache line
+template<class T, size_t Alignment = 64>
+class AlignedAllocator{
+public:
+    using value_type = T;
+
+    template<class U>
+    struct rebind{
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {}
+
+    T* allocate(const size_t n)
+    {
+        return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, const size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const
+    {
+        return true;
+    }
+};
+
+// Proxy for one vertex of a VertexStore, reading and writing the coordinate
+// arrays in place. Assigning to it assigns the coordinates.
+template<class Store>
+class VertexRef{
+private:
+    Store* store_m;
+    size_t i_m;
+public:
+    using value_type = typename std::remove_const_t<Store>::value_type;
+
+    VertexRef(Store* store, const size_t i)
+     : store_m(store), i_m(i)
+    {}
+    VertexRef(const VertexRef&) = default;
+
+    const VertexRef& operator=(const VertexRef& v) const requires(!std::is_const_v<Store>)
+    {
+        return *this = static_cast<value_type>(v);
+    }
+
+    const VertexRef& operator=(const value_type& v) const requires(!std::is_const_v<Store>)
+    {
+        for(size_t d = 0; d < store_m->dimension(); d++){
+            store_m->coordinate(d, i_m) = *(v.begin() + d);
+        }
+        return *this;
+    }
+
+    auto x() const
+    {
+        return store_m->coordinate(0, i_m);
+    }
+
+    auto y() const
+    {
+        return store_m->coordinate(1, i_m);
+    }
+
+    auto z() const
+    {
+        return store_m->coordinate(2, i_m);
+    }
+
+    operator value_type() const
+    {
+        value_type res;
+        for(size_t d = 0; d < store_m->dimension(); d++){
+            *(res.begin() + d) = store_m->coordinate(d, i_m);
+        }
+        return res;
+    }
+
+    template<class Other>
+    bool operator==(const VertexRef<Other>& b) const
+    {
+        return static_cast<value_type>(*this) == static_cast<value_type>(b);
+    }
+
+    bool operator==(const value_type& b) const
+    {
+        return static_cast<value_type>(*this) == b;
+    }
+};
+
+// Vertex coordinates stored as one aligned array per dimension
+template<Numeric Float, size_t Dim = 2>
+class VertexStore{
+private:
+    std::array<std::vector<Float, AlignedAllocator<Float>>, Dim> coordinates_m;
+public:
+    using value_type = Vertex<Float, Dim>;
+
+    VertexStore() = default;
+    VertexStore(const std::vector<value_type>& vertices)
+    {
+        assign(vertices);
+    }
+
+    void assign(const std::vector<value_type>& vertices)
+    {
+        resize(vertices.size());
+        for(size_t i = 0; i < vertices.size(); i++){
+            (*this)[i] = vertices[i];
+        }
+    }
+
+    std::vector<value_type> to_vector() const
+    {
+        std::vector<value_type> res(size());
+        for(size_t i = 0; i < size(); i++){
+            res[i] = (*this)[i];
+        }
+        return res;
+    }
+
+    static constexpr size_t dimension()
+    {
+        return Dim;
+    }
+
+    size_t size() const
+    {
+        return coordinates_m[0].size();
+    }
+
+    bool empty() const
+    {
+        return coordinates_m[0].empty();
+    }
+
+    void resize(const size_t n)
+    {
+        for(auto& c : coordinates_m){
+            c.resize(n);
+        }
+    }
+
+    void reserve(const size_t n)
+    {
+        for(auto& c : coordinates_m){
+            c.reserve(n);
+        }
+    }
+
+    void clear()
+    {
+        for(auto& c : coordinates_m){
+            c.clear();
+        }
+    }
+
+    void push_back(const value_type& v)
+    {
+        for(size_t d = 0; d < Dim; d++){
+            coordinates_m[d].push_back(*(v.begin() + d));
+        }
+    }
+
+    VertexRef<VertexStore> operator[](const size_t i)
+    {
+        return {this, i};
+    }
+
+    VertexRef<const VertexStore> operator[](const size_t i) const
+    {
+        return {this, i};
+    }
+
+    Float& coordinate(const size_t d, const size_t i)
+    {
+        return coordinates_m[d][i];
+    }
+
+    Float coordinate(const size_t d, const size_t i) const
+    {
+        return coordinates_m[d][i];
+    }
+
+    std::span<const Float> coordinates(const size_t d) const
+    {
+        return coordinates_m[d];
+    }
+};
+
+// Triangle storage with stable slots. Released slots are kept on a free
+// list and handed out again by allocate, so indices held in neighbor links
+// stay valid until compact is called.
+template<Integral Int>
+class TrianglePool{
+private:
+    std::vector<Triangle<Int>> triangles_m;
+    std::vector<bool> released_m;
+    std::vector<Int> free_m;
+public:
+    TrianglePool() = default;
+    TrianglePool(const TrianglePool&) = default;
+    TrianglePool(TrianglePool&&) = default;
+    ~TrianglePool() = default;
+
+    TrianglePool& operator=(const TrianglePool&) = default;
+    TrianglePool& operator=(TrianglePool&&) = default;
+
+    Int allocate(const Triangle<Int>& t)
+    {
+        if(free_m.empty()){
+            triangles_m.push_back(t);
+            released_m.push_back(false);
+            return static_cast<Int>(triangles_m.size() - 1);
+        }
+        Int i = free_m.back();
+        free_m.pop_back();
+        triangles_m[i] = t;
+        released_m[i] = false;
+        return i;
+    }
+
+    void release(const Int i)
+    {
+        if(!released_m[i]){
+            released_m[i] = true;
+            free_m.push_back(i);
+        }
+    }
+
+    bool alive(const Int i) const
+    {
+        return !released_m[i];
+    }
+
+    // Number of slots, including released ones
+    size_t size() const
+    {
+        return triangles_m.size();
+    }
+
+    size_t live() const
+    {
+        return triangles_m.size() - free_m.size();
+    }
+
+    void reserve(const size_t n)
+    {
+        triangles_m.reserve(n);
+        released_m.reserve(n);
+    }
+
+    void clear()
+    {
+        triangles_m.clear();
+        released_m.clear();
+        free_m.clear();
+    }
+
+    // Make exactly n live slots, to be filled through operator[]
+    void resize(const size_t n)
+    {
+        triangles_m.resize(n);
+        released_m.assign(n, false);
+        free_m.clear();
+    }
+
+    // Append n live slots, to be filled through operator[]
+    void grow(const size_t n)
+    {
+        triangles_m.resize(triangles_m.size() + n);
+        released_m.resize(released_m.size() + n, false);
+    }
+
+    // Swap the triangles in slots i and j, renumbering the links to them
+    void swap(const Int i, const Int j)
+    {
+        if(i == j){
+            return;
+        }
+        auto renumber = [i, j](Triangle<Int>& t)
+        {
+            for(auto& n : t.neighbors()){
+                if(n == OptionalIndex<Int>(i)){
+                    n = j;
+                }else if(n == OptionalIndex<Int>(j)){
+                    n = i;
+                }
+            }
+        };
+        // Renumber every outside neighbor once, it may be next to both
+        std::array<Int, 6> outer;
+        size_t m = 0;
+        for(const Int s : {i, j}){
+            for(const auto& n : triangles_m[s].neighbors()){
+                if(n && *n != i && *n != j && std::find(std::begin(outer), std::begin(outer) + m, *n) == std::begin(outer) + m){
+                    outer[m++] = *n;
+                }
+            }
+        }
+        for(size_t k = 0; k < m; k++){
+            renumber(triangles_m[outer[k]]);
+        }
+        std::swap(triangles_m[i], triangles_m[j]);
+        renumber(triangles_m[i]);
+        renumber(triangles_m[j]);
+        bool released = released_m[i];
+        released_m[i] = released_m[j];
+        released_m[j] = released;
+    }
+
+    // Drop slot i, which no live triangle links to any more, by moving the
+    // last triangle into it. Only for pools without released slots.
+    void erase(const Int i)
+    {
+        swap(i, static_cast<Int>(triangles_m.size() - 1));
+        triangles_m.pop_back();
+        released_m.pop_back();
+    }
+
+    // Move the live triangles to the front, those satisfying first before the
+    // rest but otherwise keeping their order, and renumber the neighbor links.
+    // Links to released slots are dropped.
+    template<class Predicate>
+    void compact(Predicate first)
+    {
+        std::vector<std::optional<Int>> new_index(triangles_m.size());
+        Int n = 0;
+        for(Int i = 0; i < triangles_m.size(); i++){
+            if(!released_m[i] && first(triangles_m[i])){
+                new_index[i] = n++;
+            }
+        }
+        for(Int i = 0; i < triangles_m.size(); i++){
+            if(!released_m[i] && !first(triangles_m[i])){
+                new_index[i] = n++;
+            }
+        }
+        std::vector<Triangle<Int>> res(n);
+        for(Int i = 0; i < triangles_m.size(); i++){
+            if(new_index[i]){
+                res[*new_index[i]] = triangles_m[i];
+            }
+        }
+        for(auto& t : res){
+            for(auto& nb : t.neighbors()){
+                if(nb){
+                    nb = new_index[*nb];
+                }
+            }
+        }
+        triangles_m = std::move(res);
+        released_m.assign(n, false);
+        free_m.clear();
+    }
+
+    void compact()
+    {
+        compact([](const Triangle<Int>&) {return true;});
+    }
+
+    const std::vector<Triangle<Int>>& triangles() const
+    {
+        return triangles_m;
+    }
+
+    Triangle<Int>& operator[](const Int i)
+    {
+        return triangles_m[i];
+    }
+    const Triangle<Int>& operator[](const Int i) const
+    {
+        return triangles_m[i];
+    }
+
+    auto begin()
+    {
+        return triangles_m.begin();
+    }
+    auto begin() const
+    {
+        return triangles_m.begin();
+    }
+    auto end()
+    {
+        return triangles_m.end();
+    }
+    auto end() const
+    {
+        return triangles_m.end();
+    }
+};
+
+// Quad-edge topology of Guibas and Stolfi. Edge record q holds the four
+// directed edges 4q + r, r being the rotation. Edges with r = 0 and r = 2
+// are the two directions of the primal edge and have an origin vertex,
+// r = 1 and r = 3 are the dual edges.
+template<Integral Int>
+class QuadEdges{
+private:
+    std::vector<Int> onext_m;
+    std::vector<Int> org_m;
+    std::vector<uint8_t> deleted_m;
+public:
+    QuadEdges() = default;
+    QuadEdges(const QuadEdges&) = default;
+    QuadEdges(QuadEdges&&) = default;
+    ~QuadEdges() = default;
+
+    QuadEdges& operator=(const QuadEdges&) = default;
+    QuadEdges& operator=(QuadEdges&&) = default;
+
+    static Int rot(const Int e)
+    {
+        return (e & ~Int(3)) | ((e + 1) & 3);
+    }
+    static Int rot_inv(const Int e)
+    {
+        return (e & ~Int(3)) | ((e + 3) & 3);
+    }
+    static Int sym(const Int e)
+    {
+        return e ^ 2;
+    }
+
+    Int onext(const Int e) const
+    {
+        return onext_m[e];
+    }
+    Int oprev(const Int e) const
+    {
+        return rot(onext(rot(e)));
+    }
+    Int lnext(const Int e) const
+    {
+        return rot(onext(rot_inv(e)));
+    }
+    Int lprev(const Int e) const
+    {
+        return sym(onext(e));
+    }
+    Int rprev(const Int e) const
+    {
+        return onext(sym(e));
+    }
+    Int org(const Int e) const
+    {
+        return org_m[e];
+    }
+    Int dest(const Int e) const
+    {
+        return org_m[sym(e)];
+    }
+
+    // Number of directed edges, including deleted ones
+    size_t size() const
+    {
+        return onext_m.size();
+    }
+
+    bool deleted(const Int e) const
+    {
+        return deleted_m[e/4];
+    }
+
+    void reserve(const size_t edges)
+    {
+        onext_m.reserve(4*edges);
+        org_m.reserve(4*edges);
+        deleted_m.reserve(edges);
+    }
+
+    void resize(const size_t edges)
+    {
+        onext_m.resize(4*edges);
+        org_m.resize(4*edges);
+        deleted_m.resize(edges);
+    }
+
+    // Copy the edge records of other into the records starting at offset,
+    // renumbering them. Copies into disjoint records may run concurrently.
+    void assign(const QuadEdges& other, const Int offset)
+    {
+        const auto at = static_cast<std::ptrdiff_t>(offset);
+        std::ranges::transform(other.onext_m, std::begin(onext_m) + 4*at, [&](const Int e) {return e + 4*offset;});
+        std::ranges::copy(other.org_m, std::begin(org_m) + 4*at);
+        std::ranges::copy(other.deleted_m, std::begin(deleted_m) + at);
+    }
+
+    Int make_edge(const Int a, const Int b)
+    {
+        Int e = static_cast<Int>(onext_m.size());
+        onext_m.insert(std::end(onext_m), {e, e + 3, e + 2, e + 1});
+        org_m.insert(std::end(org_m), {a, a, b, b});
+        deleted_m.push_back(false);
+        return e;
+    }
+
+    void splice(const Int a, const Int b)
+    {
+        Int alpha = rot(onext(a)), beta = rot(onext(b));
+        std::swap(onext_m[a], onext_m[b]);
+        std::swap(onext_m[alpha], onext_m[beta]);
+    }
+
+    // New edge from the destination of a to the origin of b
+    Int connect(const Int a, const Int b)
+    {
+        Int e = make_edge(dest(a), org(b));
+        splice(e, lnext(a));
+        splice(sym(e), b);
+        return e;
+    }
+
+    void remove(const Int e)
+    {
+        splice(e, oprev(e));
+        splice(sym(e), oprev(sym(e)));
+        deleted_m[e/4] = true;
+    }
+};
+
+// Half-edge topology of a triangle mesh. Face f owns the half-edges 3f,
+// 3f + 1 and 3f + 2, half-edge 3f + k running from vertex k of the face to
+// vertex k + 1, so next and prev need no storage. Built from a
+// triangulation with its ghost triangles the mesh is closed: every
+// half-edge has a twin, and flips, turns around a vertex and steps along
+// the convex hull are all constant time.
+template<Integral Int>
+class HalfEdges{
+private:
+    std::vector<Int> twin_m;
+    std::vector<Int> vertex_m;
+    std::vector<Int> edge_m;
+public:
+    static constexpr Int none = std::numeric_limits<Int>::max();
+    static constexpr Int infinite_vertex = std::numeric_limits<Int>::max();
+
+    HalfEdges() = default;
+    HalfEdges(const HalfEdges&) = default;
+    HalfEdges(HalfEdges&&) = default;
+    ~HalfEdges() = default;
+
+    // Face i is triangle i. Neighbor links become twins, missing ones none.
+    HalfEdges(std::span<const Triangle<Int>> triangles, const size_t vertices)
+     : twin_m(3*triangles.size(), none), vertex_m(3*triangles.size()), edge_m(vertices, none)
+    {
+        for(Int f = 0; f < triangles.size(); f++){
+            const auto& t = triangles[f];
+            for(Int k = 0; k < 3; k++){
+                const Int h = 3*f + k, v = t.vertices()[k];
+                vertex_m[h] = v;
+                if(v != infinite_vertex){
+                    edge_m[v] = h;
+                }
+                const auto nb = t.neighbors()[(k + 2) % 3];
+                if(nb){
+                    const auto& u = triangles[*nb].vertices();
+                    const auto j = static_cast<Int>(std::ranges::find(u, t.vertices()[(k + 1) % 3]) - std::begin(u));
+                    twin_m[h] = 3*(*nb) + j;
+                }
+            }
+        }
+    }
+
+    HalfEdges& operator=(const HalfEdges&) = default;
+    HalfEdges& operator=(HalfEdges&&) = default;
+
+    static Int next(const Int h)
+    {
+        return h % 3 == 2 ? h - 2 : h + 1;
+    }
+    static Int prev(const Int h)
+    {
+        return h % 3 == 0 ? h + 2 : h - 1;
+    }
+    static Int face(const Int h)
+    {
+        return h / 3;
+    }
+
+    Int twin(const Int h) const
+    {
+        return twin_m[h];
+    }
+    Int org(const Int h) const
+    {
+        return vertex_m[h];
+    }
+    Int dest(const Int h) const
+    {
+        return vertex_m[next(h)];
+    }
+
+    // Some half-edge leaving vertex v, none for vertices not in the mesh
+    Int edge(const Int v) const
+    {
+        return edge_m[v];
+    }
+
+    // Next half-edge leaving the origin of h, counterclockwise
+    Int rotate(const Int h) const
+    {
+        return twin(prev(h));
+    }
+
+    // Number of half-edges
+    size_t size() const
+    {
+        return vertex_m.size();
+    }
+
+    size_t faces() const
+    {
+        return vertex_m.size() / 3;
+    }
+
+    size_t vertices() const
+    {
+        return edge_m.size();
+    }
+
+    bool is_ghost(const Int h) const
+    {
+        const Int h0 = 3*face(h);
+        return vertex_m[h0] == infinite_vertex || vertex_m[h0 + 1] == infinite_vertex
+            || vertex_m[h0 + 2] == infinite_vertex;
+    }
+
+    // Call f with every finite half-edge leaving v, counterclockwise.
+    // The mesh has to be closed.
+    template<class Function>
+    void for_each_star(const Int v, Function f) const
+    {
+        const Int start = edge_m[v];
+        if(start == none){
+            return;
+        }
+        Int h = start;
+        do{
+            if(dest(h) != infinite_vertex){
+                f(h);
+            }
+            h = rotate(h);
+        }while(h != start);
+    }
+
+    // Whether h lies on the convex hull with its finite face to the left
+    bool is_hull(const Int h) const
+    {
+        return !is_ghost(h) && is_ghost(twin(h));
+    }
+
+    // Some hull half-edge, none if the mesh has no ghost faces
+    Int hull_edge() const
+    {
+        for(Int h = 0; h < size(); h++){
+            if(twin_m[h] != none && is_hull(h)){
+                return h;
+            }
+        }
+        return none;
+    }
+
+    // Hull half-edge following the hull half-edge h, counterclockwise. It
+    // leaves the destination of h, and is found through the two ghost faces
+    // at that vertex.
+    Int next_hull(const Int h) const
+    {
+        return twin(prev(twin(prev(twin(h)))));
+    }
+
+    // Call f with every hull half-edge, counterclockwise from hull_edge()
+    template<class Function>
+    void for_each_hull(Function f) const
+    {
+        const Int start = hull_edge();
+        if(start == none){
+            return;
+        }
+        Int h = start;
+        do{
+            f(h);
+            h = next_hull(h);
+        }while(h != start);
+    }
+
+    // Replace the edge of h by the other diagonal of the quadrilateral formed
+    // by the faces of h and its twin, which has to be convex. Afterwards h
+    // and its twin both lie on the new diagonal's faces; h leaves the vertex
+    // opposite h in the twin face and ends at the destination of h.
+    void flip(const Int h)
+    {
+        const Int g = twin(h);
+        const Int hn = next(h), hp = prev(h), gn = next(g), gp = prev(g);
+        const Int a = org(h), b = dest(h), c = org(hp), d = org(gp);
+        const Int hpt = twin(hp), gpt = twin(gp);
+
+        vertex_m[h] = d;
+        vertex_m[g] = c;
+        link(h, gpt);
+        link(g, hpt);
+        link(hp, gp);
+
+        if(edge_m[a] == h){
+            edge_m[a] = gn;
+        }
+        if(edge_m[b] == g){
+            edge_m[b] = hn;
+        }
+    }
+
+    // The faces as triangles, twins turned back into neighbor links
+    std::vector<Triangle<Int>> triangles() const
+    {
+        std::vector<Triangle<Int>> res(faces());
+        for(Int f = 0; f < res.size(); f++){
+            auto& t = res[f];
+            for(Int k = 0; k < 3; k++){
+                const Int h = 3*f + k;
+                t.vertices()[k] = vertex_m[h];
+                if(twin_m[h] != none){
+                    t.neighbors()[(k + 2) % 3] = face(twin_m[h]);
+                }
+            }
+        }
+        return res;
+    }
+
+private:
+    void link(const Int h, const Int g)
+    {
+        twin_m[h] = g;
+        if(g != none){
+            twin_m[g] = h;
+        }
+    }
+};
+
+enum class Engine{
+    incremental,
+    divide_and_conquer,
+    sweep_hull
+};
+
+enum class Location{
+    inside,
+    edge,
+    vertex,
+    outside
+};
+
+enum class InsertionOrder{
+    given,
+    brio
+};
+
+enum class WalkStart{
+    last_triangle,
+    jump_and_walk
+};
+
+enum class Interpolation{
+    linear,
+    natural_neighbor
+};
+
+// Regular grid of nx by ny points, point (i, j) at (x0 + i*dx, y0 + j*dy),
+// stored row by row
+template<Numeric Float>
+struct Grid{
+    Float x0 = 0, y0 = 0;
+    Float dx = 1, dy = 1;
+    size_t nx = 0, ny = 0;
+
+    size_t size() const
+    {
+        return nx*ny;
+    }
+
+    Vertex<Float> operator()(const size_t i, const size_t j) const
+    {
+        return {x0 + static_cast<Float>(i)*dx, y0 + static_cast<Float>(j)*dy};
+    }
+};
+
+struct WalkStatistics{
+    size_t walks = 0;
+    size_t steps = 0;
+    size_t max_steps = 0;
+
+    double mean_steps() const
+    {
+        return walks == 0 ? 0. : static_cast<double>(steps)/static_cast<double>(walks);
+    }
+};
+
+struct FlipStatistics{
+    size_t insertions = 0;
+    size_t flips = 0;
+    size_t max_flips = 0;
+
+    double mean_flips() const
+    {
+        return insertions == 0 ? 0. : static_cast<double>(flips)/static_cast<double>(insertions);
+    }
+};
+
+// Instrumentation of Delaunay, chosen by its last template parameter: events
+// counted, distributions recorded and phases of work timed
+enum class Counter{
+    orientation_tests,
+    incircle_tests,
+    walks,
+    walk_steps,
+    insertions,
+    flips,
+    removals,
+    triangle_allocations,
+    triangle_releases
+};
+
+enum class Distribution{
+    walk_steps,
+    flips_per_insertion,
+    // Triangles replaced by an insertion or around a removed vertex
+    cavity_size,
+    insertion_nanoseconds
+};
+
+enum class Phase{
+    triangulate,
+    insertion_order,
+    incremental,
+    divide_and_conquer,
+    sweep_hull,
+    compact,
+    insert,
+    remove,
+    move,
+    voronoi,
+    adjacency,
+    save,
+    load
+};
+
+inline constexpr std::array<std::string_view, 9> counter_names{
+    "orientation_tests", "incircle_tests", "walks", "walk_steps", "insertions", "flips", "removals",
+    "triangle_allocations", "triangle_releases"};
+inline constexpr std::array<std::string_view, 4> distribution_names{
+    "walk_steps", "flips_per_insertion", "cavity_size", "insertion_nanoseconds"};
+inline constexpr std::array<std::string_view, 13> phase_names{
+    "triangulate", "insertion_order", "incremental", "divide_and_conquer", "sweep_hull", "compact",
+    "insert", "remove", "move", "voronoi", "adjacency", "save", "load"};
+
+// Counts of values in power of two buckets, bucket 0 holding the zeros and
+// bucket b the values from 2^(b - 1) to 2^b - 1
+struct Histogram{
+    std::array<uint64_t, 65> buckets{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    double mean() const
+    {
+        return count == 0 ? 0. : static_cast<double>(sum)/static_cast<double>(count);
+    }
+
+    // Upper end of the first bucket by which a fraction q of the values is
+    // reached
+    uint64_t quantile(const double q) const
+    {
+        uint64_t seen = 0;
+        for(size_t b = 0; b < buckets.size(); b++){
+            seen += buckets[b];
+            if(count > 0 && static_cast<double>(seen) >= q*static_cast<double>(count)){
+                return b == 0 ? 0 : (b == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << b) - 1);
+            }
+        }
+        return 0;
+    }
+};
+
+struct InstrumentationStats{
+    std::array<uint64_t, counter_names.size()> counters{};
+    std::array<Histogram, distribution_names.size()> distributions{};
+    // Wall time spent in each phase, nested phases counting towards both
+    std::array<double, phase_names.size()> phase_seconds{};
+    std::array<uint64_t, phase_names.size()> phase_runs{};
+
+    uint64_t operator[](const Counter c) const
+    {
+        return counters[static_cast<size_t>(c)];
+    }
+
+    const Histogram& operator[](const Distribution d) const
+    {
+        return distributions[static_cast<size_t>(d)];
+    }
+
+    double seconds(const Phase p) const
+    {
+        return phase_seconds[static_cast<size_t>(p)];
+    }
+};
+
+template<class P>
+concept InstrumentationPolicy = requires(P& p, const Counter c, const Distribution d, const Phase ph, const uint64_t n){
+    p.count(c, n);
+    p.record(d, n);
+    p.phase(ph);
+    p.time(d);
+};
+
+// The default: every call is empty and inlined away, and the scopes
+// returned are empty, so an uninstrumented Delaunay pays nothing
+struct NoInstrumentation{
+    // The destructor only keeps unused-variable warnings quiet
+    struct Scope{
+        ~Scope() {}
+    };
+
+    void count(Counter, uint64_t = 1) {}
+    void record(Distribution, uint64_t) {}
+    Scope phase(Phase)
+    {
+        return {};
+    }
+    Scope time(Distribution)
+    {
+        return {};
+    }
+};
+
+// Counters and histograms are updated atomically, so they may be fed from
+// several threads at once. Phases are timed by the thread running the
+// operation that enters them, and are kept as trace events, up to
+// trace_capacity() of them, for write_trace(). Const operations such as
+// save() enter phases too and may run concurrently, so the phase totals and
+// the trace are updated under a lock. Read stats() while nothing runs.
+class Instrumentation{
+public:
+    // Ends the phase or timed span it was returned for when it goes out of
+    // scope
+    class Scope{
+    private:
+        Instrumentation* owner_m = nullptr;
+        std::chrono::steady_clock::time_point start_m;
+        size_t index_m = 0;
+        bool phase_m = false;
+    public:
+        Scope(Instrumentation* owner, const size_t index, const bool phase)
+         : owner_m(owner), start_m(std::chrono::steady_clock::now()), index_m(index), phase_m(phase)
+        {}
+        Scope(const Scope&) = delete;
+        Scope(Scope&& s)
+         : owner_m(std::exchange(s.owner_m, nullptr)), start_m(s.start_m), index_m(s.index_m), phase_m(s.phase_m)
+        {}
+
+        ~Scope()
+        {
+            if(owner_m != nullptr){
+                owner_m->finish(*this, std::chrono::steady_clock::now());
+            }
+        }
+
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+        friend class Instrumentation;
+    };
+private:
+    struct TraceEvent{
+        size_t phase;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration duration;
+        std::thread::id thread;
+    };
+
+    InstrumentationStats stats_m;
+    std::chrono::steady_clock::time_point epoch_m = std::chrono::steady_clock::now();
+    std::vector<TraceEvent> trace_m;
+    size_t trace_capacity_m = size_t(1) << 20;
+    uint64_t dropped_m = 0;
+    // Guards the phase totals, trace_m and dropped_m
+    mutable std::mutex phases_m;
+
+    static void add(uint64_t& counter, const uint64_t n)
+    {
+        std::atomic_ref(counter).fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void finish(const Scope& s, const std::chrono::steady_clock::time_point end)
+    {
+        const auto duration = end - s.start_m;
+        if(!s.phase_m){
+            record(static_cast<Distribution>(s.index_m), static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+            return;
+        }
+        std::scoped_lock lock(phases_m);
+        stats_m.phase_seconds[s.index_m] += std::chrono::duration<double>(duration).count();
+        stats_m.phase_runs[s.index_m]++;
+        if(trace_m.size() < trace_capacity_m){
+            trace_m.push_back({s.index_m, s.start_m, duration, std::this_thread::get_id()});
+        }else{
+            dropped_m++;
+        }
+    }
+public:
+    Instrumentation() = default;
+    Instrumentation(const Instrumentation& other)
+     : Instrumentation()
+    {
+        *this = other;
+    }
+
+    Instrumentation& operator=(const Instrumentation& other)
+    {
+        if(this != &other){
+            std::scoped_lock lock(phases_m, other.phases_m);
+            stats_m = other.stats_m;
+            epoch_m = other.epoch_m;
+            trace_m = other.trace_m;
+            trace_capacity_m = other.trace_capacity_m;
+            dropped_m = other.dropped_m;
+        }
+        return *this;
+    }
+
+    void count(const Counter c, const uint64_t n = 1)
+    {
+        add(stats_m.counters[static_cast<size_t>(c)], n);
+    }
+
+    void record(const Distribution d, const uint64_t value)
+    {
+        auto& h = stats_m.distributions[static_cast<size_t>(d)];
+        add(h.buckets[std::bit_width(value)], 1);
+        add(h.count, 1);
+        add(h.sum, value);
+        std::atomic_ref max(h.max);
+        uint64_t seen = max.load(std::memory_order_relaxed);
+        while(value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)){}
+    }
+
+    [[nodiscard]] Scope phase(const Phase p)
+    {
+        return Scope(this, static_cast<size_t>(p), true);
+    }
+
+    // Time until the end of the scope, recorded in nanoseconds under d
+    [[nodiscard]] Scope time(const Distribution d)
+    {
+        return Scope(this, static_cast<size_t>(d), false);
+    }
+
+    const InstrumentationStats& stats() const
+    {
+        return stats_m;
+    }
+
+    void reset()
+    {
+        std::scoped_lock lock(phases_m);
+        stats_m = InstrumentationStats();
+        trace_m.clear();
+        dropped_m = 0;
+        epoch_m = std::chrono::steady_clock::now();
+    }
+
+    size_t trace_capacity() const
+    {
+        return trace_capacity_m;
+    }
+
+    void trace_capacity(const size_t n)
+    {
+        std::scoped_lock lock(phases_m);
+        trace_capacity_m = n;
+    }
+
+    // Phases as complete events, and the counters at the end, in the trace
+    // event format read by chrome://tracing and Perfetto
+    void write_trace(std::ostream& os) const
+    {
+        auto microseconds = [](const auto d) {return std::chrono::duration<double, std::micro>(d).count();};
+        std::vector<std::thread::id> threads;
+        auto thread = [&threads](const std::thread::id id)
+        {
+            auto it = std::ranges::find(threads, id);
+            if(it == std::end(threads)){
+                threads.push_back(id);
+                return threads.size() - 1;
+            }
+            return static_cast<size_t>(it - std::begin(threads));
+        };
+        std::scoped_lock lock(phases_m);
+        os << "{\"traceEvents\":[";
+        auto end = epoch_m;
+        for(const auto& e : trace_m){
+            os << "\n{\"name\":\"" << phase_names[e.phase] << "\",\"cat\":\"delaunay\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread(e.thread)
+               << ",\"ts\":" << microseconds(e.start - epoch_m) << ",\"dur\":" << microseconds(e.duration) << "},";
+            end = std::max(end, e.start + e.duration);
+        }
+        os << "\n{\"name\":\"counters\",\"cat\":\"delaunay\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << microseconds(end - epoch_m) << ",\"args\":{";
+        for(size_t i = 0; i < counter_names.size(); i++){
+            os << (i > 0 ? "," : "") << "\"" << counter_names[i] << "\":" << stats_m.counters[i];
+        }
+        os << "}}\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << dropped_m << "}}\n";
+    }
+};
+
+template<Numeric Float, Integral Int, InstrumentationPolicy Policy = NoInstrumentation>
+class Delaunay;
+
+// Voronoi diagram in compressed sparse row form. Diagram vertex i, for i
+// below the number of finite triangles, is the circumcenter of triangle i;
+// cells clipped to the bounding box get vertices of their own after those.
+// The cell of vertex v runs counterclockwise through the diagram vertices
+// indices()[offsets()[v]] to indices()[offsets()[v + 1] - 1], and is empty
+// for a vertex that is not part of the triangulation.
+template<Numeric Float, Integral Int>
+class VoronoiDiagram{
+private:
+    std::vector<Float> x_m;
+    std::vector<Float> y_m;
+    std::vector<size_t> offsets_m;
+    std::vector<Int> indices_m;
+
+    template<Numeric F, Integral I, InstrumentationPolicy P>
+    friend class Delaunay;
+public:
+    // Number of cells
+    size_t size() const
+    {
+        return offsets_m.empty() ? 0 : offsets_m.size() - 1;
+    }
+
+    std::span<const Float> x() const
+    {
+        return x_m;
+    }
+
+    std::span<const Float> y() const
+    {
+        return y_m;
+    }
+
+    Vertex<Float> vertex(const size_t i) const
+    {
+        return {x_m[i], y_m[i]};
+    }
+
+    std::span<const size_t> offsets() const
+    {
+        return offsets_m;
+    }
+
+    std::span<const Int> indices() const
+    {
+        return indices_m;
+    }
+
+    std::span<const Int> cell(const size_t v) const
+    {
+        return std::span(indices_m).subspan(offsets_m[v], offsets_m[v + 1] - offsets_m[v]);
+    }
+};
+
+// Vertex adjacency in compressed sparse row form. The neighbors of vertex v
+// are vertices()[vertex_offsets()[v]] to vertices()[vertex_offsets()[v + 1] - 1]
+// and the finite triangles around it, numbered as in triangles_view(), are
+// laid out likewise in triangles(). Both run counterclockwise around v, for a
+// hull vertex starting from the hull neighbor after it.
+template<Integral Int>
+class Adjacency{
+private:
+    std::vector<size_t> vertex_offsets_m;
+    std::vector<Int> vertices_m;
+    std::vector<size_t> triangle_offsets_m;
+    std::vector<Int> triangles_m;
+
+    template<Numeric F, Integral I, InstrumentationPolicy P>
+    friend class Delaunay;
+public:
+    // Number of vertices
+    size_t size() const
+    {
+        return vertex_offsets_m.empty() ? 0 : vertex_offsets_m.size() - 1;
+    }
+
+    std::span<const size_t> vertex_offsets() const
+    {
+        return vertex_offsets_m;
+    }
+
+    std::span<const Int> vertices() const
+    {
+        return vertices_m;
+    }
+
+    std::span<const Int> vertices(const size_t v) const
+    {
+        return std::span(vertices_m).subspan(vertex_offsets_m[v], vertex_offsets_m[v + 1] - vertex_offsets_m[v]);
+    }
+
+    std::span<const size_t> triangle_offsets() const
+    {
+        return triangle_offsets_m;
+    }
+
+    std::span<const Int> triangles() const
+    {
+        return triangles_m;
+    }
+
+    std::span<const Int> triangles(const size_t v) const
+    {
+        return std::span(triangles_m).subspan(triangle_offsets_m[v], triangle_offsets_m[v + 1] - triangle_offsets_m[v]);
+    }
+};
+
+#include "delaunay-snapshot.h"
+
+template<Numeric Float, Integral Int, InstrumentationPolicy Policy>
+class Delaunay{
+private:
+    VertexStore<Float> vertices_m;
+    // Derived on demand and kept until the triangulation changes
+    std::vector<Edge<Int>> edges_m;
+    bool edges_valid_m = false;
+    Adjacency<Int> adjacency_m;
+    bool adjacency_valid_m = false;
+    // The convex hull is closed off by ghost triangles, each joining a hull
+    // edge to the vertex at infinity. They are kept after the finite
+    // triangles in triangles_m, which finite_m counts.
+    TrianglePool<Int> triangles_m;
+    Int finite_m = 0;
+    InsertionOrder insertion_order_m = InsertionOrder::given;
+    WalkStart walk_start_m = WalkStart::last_triangle;
+    unsigned threads_m = 1;
+    WalkStatistics walk_statistics_m;
+    std::minstd_rand walk_rng_m;
+    FlipStatistics flip_statistics_m;
+    std::vector<Int> flip_stack_m;
+    // A triangle around each vertex, for remove() and move(). Built on first
+    // use and checked before every use, so stale entries only cost a walk.
+    std::vector<Int> vertex_triangles_m;
+    // Change in the number of finite triangles made by insert() and flip()
+    Int finite_delta_m = 0;
+    std::vector<Int> star_m;
+    std::vector<Int> link_m;
+    std::vector<std::tuple<Int, Int>> edge_stack_m;
+    // Voronoi dual, built by voronoi(). Triangle slots changed by edits since
+    // are listed in changed_m, only their circumcenters are recomputed and
+    // only the cells of their vertices gathered again. The first
+    // voronoi_finite_m diagram vertices are circumcenters.
+    VoronoiDiagram<Float, Int> voronoi_m;
+    bool circumcenters_valid_m = false;
+    bool cells_valid_m = false;
+    std::array<Float, 4> voronoi_box_m{};
+    std::vector<Int> changed_m;
+    Int voronoi_finite_m = 0;
+    // Compiled away for NoInstrumentation
+    [[no_unique_address]] mutable Policy instrumentation_m;
+public:
+    static constexpr Int infinite_vertex = std::numeric_limits<Int>::max();
+
+    Delaunay() = default;
+    Delaunay(const Delaunay&) = default;
+    Delaunay(Delaunay&&) = default;
+
+    ~Delaunay() = default;
+
+    Delaunay& operator=(const Delaunay&) = default;
+    Delaunay& operator=(Delaunay&&) = default;
+
+    std::vector<Vertex<Float>> vertices() const
+    {
+        return vertices_m.to_vector();
+    }
+
+    std::vector<Edge<Int>> edges() const
+    {
+        if(edges_valid_m){
+            return edges_m;
+        }
+        std::vector<Edge<Int>> res;
+        collect_edges(res);
+        return res;
+    }
+
+    // Every edge once, from the first vertex to the second with the finite
+    // triangle to its left. Hull edges have no triangle to their right.
+    std::span<const Edge<Int>> edges_view()
+    {
+        if(!edges_valid_m){
+            collect_edges(edges_m);
+            edges_valid_m = true;
+        }
+        return edges_m;
+    }
+
+    const Adjacency<Int>& adjacency()
+    {
+        if(adjacency_valid_m){
+            return adjacency_m;
+        }
+        auto phase = instrumentation_m.phase(Phase::adjacency);
+        auto& adj = adjacency_m;
+        const size_t n = vertices_m.size();
+        std::vector<Int> around(n, OptionalIndex<Int>::none);
+        for(Int t = 0; t < triangles_m.size(); t++){
+            for(const Int v : triangles_m[t]){
+                if(v != infinite_vertex){
+                    around[v] = t;
+                }
+            }
+        }
+        adj.vertex_offsets_m.assign(n + 1, 0);
+        adj.triangle_offsets_m.assign(n + 1, 0);
+        adj.vertices_m.clear();
+        adj.triangles_m.clear();
+        adj.vertices_m.reserve(6*n);
+        adj.triangles_m.reserve(3*size_t(finite_m));
+        for(size_t v = 0; v < n; v++){
+            if(around[v] != OptionalIndex<Int>::none){
+                collect_star(static_cast<Int>(v), around[v]);
+                const size_t k = link_m.size();
+                const size_t start = static_cast<size_t>(std::ranges::find(link_m, infinite_vertex) - std::begin(link_m) + 1) % k;
+                for(size_t j = 0; j < k; j++){
+                    const size_t i = (start + j) % k;
+                    if(link_m[i] != infinite_vertex){
+                        adj.vertices_m.push_back(link_m[i]);
+                    }
+                    if(star_m[i] < finite_m){
+                        adj.triangles_m.push_back(star_m[i]);
+                    }
+                }
+            }
+            adj.vertex_offsets_m[v + 1] = adj.vertices_m.size();
+            adj.triangle_offsets_m[v + 1] = adj.triangles_m.size();
+        }
+        adjacency_valid_m = true;
+        return adj;
+    }
+
+    std::vector<Triangle<Int>> triangles() const
+    {
+        std::vector<Triangle<Int>> res(std::begin(triangles_m), std::begin(triangles_m) + static_cast<std::ptrdiff_t>(finite_m));
+        for(auto& t : res){
+            for(auto& n : t.neighbors()){
+                if(n && *n >= finite_m){
+                    n.reset();
+                }
+            }
+        }
+        return res;
+    }
+
+    const WalkStatistics& walk_statistics() const
+    {
+        return walk_statistics_m;
+    }
+
+    void reset_walk_statistics()
+    {
+        walk_statistics_m = WalkStatistics();
+    }
+
+    void insertion_order(const InsertionOrder order)
+    {
+        insertion_order_m = order;
+    }
+
+    void walk_start(const WalkStart start)
+    {
+        walk_start_m = start;
+    }
+
+    // Threads used by the divide-and-conquer engine and by batch queries, 0
+    // for one per core
+    void threads(const unsigned n)
+    {
+        threads_m = n > 0 ? n : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    const FlipStatistics& flip_statistics() const
+    {
+        return flip_statistics_m;
+    }
+
+    void reset_flip_statistics()
+    {
+        flip_statistics_m = FlipStatistics();
+    }
+
+    // Counters, distributions and phase timings, see Instrumentation
+    const Policy& instrumentation() const
+    {
+        return instrumentation_m;
+    }
+
+    Policy& instrumentation()
+    {
+        return instrumentation_m;
+    }
+
+    std::vector<Edge<Float>> edges_coord() const
+    {
+        auto edges = this->edges();
+        std::vector<Edge<Float>> res;
+        res.reserve(edges.size());
+        std::ranges::transform(edges, std::back_inserter(res),
+            [&] (const Edge<Int>& edge)
+            {
+                auto [a, b] = edge.vertices();
+                return Edge<Float>{Vertex<Float>(vertices_m[a]), Vertex<Float>(vertices_m[b])};
+            }
+        );
+        return res;
+    }
+
+    std::vector<Triangle<Float>> triangles_coord() const
+    {
+        std::vector<Triangle<Float>> res;
+        res.reserve(finite_m);
+        std::ranges::copy(triangles_coord_view(), std::back_inserter(res));
+        return res;
+    }
+
+    // The finite triangles in place. Unlike triangles(), neighbor links
+    // across the convex hull are kept, pointing at ghost triangles with
+    // indices from triangles_view().size() on.
+    std::span<const Triangle<Int>> triangles_view() const
+    {
+        return std::span(triangles_m.triangles()).first(finite_m);
+    }
+
+    // Lazy view of the vertices as proxies into the coordinate arrays
+    auto vertices_view() const
+    {
+        return std::views::iota(size_t(0), vertices_m.size())
+             | std::views::transform([this](const size_t i) {return vertices_m[i];});
+    }
+
+    // Coordinate d of every vertex
+    std::span<const Float> coordinates(const size_t d) const
+    {
+        return vertices_m.coordinates(d);
+    }
+
+    auto triangles_coord_view() const
+    {
+        return triangles_view() | std::views::transform([this](const Triangle<Int>& t)
+            {
+                auto [ai, bi, ci] = t.vertices();
+                return Triangle<Float>{vertices_m[ai], vertices_m[bi], vertices_m[ci]};
+            });
+    }
+
+    size_t triangle_count() const
+    {
+        return finite_m;
+    }
+
+    // Three vertex indices per finite triangle, written to the start of out.
+    // Returns the number of indices written.
+    size_t index_buffer(std::span<uint32_t> out) const
+    {
+        if(out.size() < 3*size_t(finite_m)){
+            throw std::length_error("Index buffer holds fewer than three indices per triangle");
+        }
+        if(vertices_m.size() > std::numeric_limits<uint32_t>::max()){
+            throw std::overflow_error("Vertex indices do not fit in 32 bits");
+        }
+        auto it = std::begin(out);
+        for(const auto& t : triangles_view()){
+            for(const Int v : t){
+                *it++ = static_cast<uint32_t>(v);
+            }
+        }
+        return 3*finite_m;
+    }
+
+    std::vector<uint32_t> index_buffer() const
+    {
+        std::vector<uint32_t> res(3*size_t(finite_m));
+        index_buffer(res);
+        return res;
+    }
+
+    // Half-edge form of the triangulation. Ghost triangles are included so
+    // every half-edge has a twin; faces are numbered as in triangles_view(),
+    // the ghost faces following the finite ones.
+    HalfEdges<Int> half_edges() const
+    {
+        return HalfEdges<Int>(std::span(triangles_m.triangles()), vertices_m.size());
+    }
+
+    // Take the topology of a closed half-edge mesh over the current vertices,
+    // e.g. one returned by half_edges() and modified by flips
+    void assign_half_edges(const HalfEdges<Int>& mesh)
+    {
+        if(mesh.vertices() != vertices_m.size()){
+            throw std::invalid_argument("Half-edge mesh is over a different vertex set");
+        }
+        auto ts = mesh.triangles();
+        triangles_m.resize(ts.size());
+        std::ranges::copy(ts, std::begin(triangles_m));
+        triangles_m.compact([this](const Triangle<Int>& t) {return !is_ghost(t);});
+        finite_m = static_cast<Int>(std::ranges::count_if(triangles_m, [this](const Triangle<Int>& t) {return !is_ghost(t);}));
+        invalidate_derived();
+    }
+
+    // Read-only view for point location and nearest vertex queries, valid
+    // until the triangulation changes. It has no triangles around vertices,
+    // use adjacency() instead.
+    DelaunayView<Float, Int> view() const
+    {
+        return {vertices_m.coordinates(0), vertices_m.coordinates(1), triangles_m.triangles(), finite_m};
+    }
+
+    // Write the triangulation as a snapshot, see SnapshotHeader, for
+    // DelaunayView to use in place or load() to read back. A checksum costs
+    // one more pass over the data. Write errors are left in the stream state.
+    void save(std::ostream& os, const bool checksum = false) const
+    {
+        if constexpr(std::endian::native != std::endian::little){
+            throw std::domain_error("Snapshots are little-endian and can only be written on little-endian machines");
+        }
+        auto phase = instrumentation_m.phase(Phase::save);
+        const size_t n = vertices_m.size();
+        std::vector<Int> around(n, OptionalIndex<Int>::none);
+        for(Int t = 0; t < triangles_m.size(); t++){
+            for(const Int v : triangles_m[t]){
+                if(v != infinite_vertex){
+                    around[v] = t;
+                }
+            }
+        }
+        const std::array<std::span<const std::byte>, 4> sections{
+            std::as_bytes(vertices_m.coordinates(0)), std::as_bytes(vertices_m.coordinates(1)),
+            std::as_bytes(std::span(triangles_m.triangles())), std::as_bytes(std::span(around))};
+        auto align = [](const size_t i) {return (i + SnapshotHeader::alignment - 1)/SnapshotHeader::alignment*SnapshotHeader::alignment;};
+        std::array<size_t, 5> offsets{sizeof(SnapshotHeader)};
+        for(size_t i = 0; i < sections.size(); i++){
+            offsets[i + 1] = align(offsets[i] + sections[i].size());
+        }
+        SnapshotHeader h;
+        h.float_size = sizeof(Float);
+        h.float_floating = std::is_floating_point_v<Float>;
+        h.int_size = sizeof(Int);
+        h.vertices = n;
+        h.triangles = triangles_m.size();
+        h.finite = finite_m;
+        h.x_offset = offsets[0];
+        h.y_offset = offsets[1];
+        h.triangles_offset = offsets[2];
+        h.vertex_triangles_offset = offsets[3];
+        h.size = offsets[4];
+        // Every section followed by its padding
+        static constexpr std::array<std::byte, SnapshotHeader::alignment> zeros{};
+        auto for_each_piece = [&](auto&& f)
+        {
+            for(size_t i = 0; i < sections.size(); i++){
+                f(sections[i]);
+                f(std::span(zeros).first(offsets[i + 1] - offsets[i] - sections[i].size()));
+            }
+        };
+        if(checksum){
+            SnapshotChecksum sum;
+            for_each_piece([&](std::span<const std::byte> piece) {sum.update(piece);});
+            h.flags |= SnapshotHeader::has_checksum;
+            h.checksum = sum.value();
+        }
+        os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        for_each_piece([&](std::span<const std::byte> piece) {os.write(reinterpret_cast<const char*>(piece.data()), static_cast<std::streamsize>(piece.size()));});
+    }
+
+    // Copy of the triangulation a view is over, e.g. one of a snapshot,
+    // checked by DelaunayView::validate() first
+    void assign(const DelaunayView<Float, Int>& view)
+    {
+        view.validate();
+        const size_t n = view.size();
+        vertices_m.resize(n);
+        for(size_t i = 0; i < n; i++){
+            vertices_m.coordinate(0, i) = view.coordinates(0)[i];
+            vertices_m.coordinate(1, i) = view.coordinates(1)[i];
+        }
+        auto slots = view.triangle_slots();
+        triangles_m.resize(slots.size());
+        std::ranges::copy(slots, std::begin(triangles_m));
+        finite_m = static_cast<Int>(view.triangle_count());
+        // Without triangles around vertices in the view they are found again
+        // on first use
+        vertex_triangles_m.clear();
+        if(view.has_vertex_triangles()){
+            vertex_triangles_m.resize(n);
+            for(size_t v = 0; v < n; v++){
+                vertex_triangles_m[v] = *view.vertex_triangle(static_cast<Int>(v));
+            }
+        }
+        finite_delta_m = 0;
+        invalidate_derived();
+    }
+
+    // Read a snapshot written by save(), checking its checksum if it has one
+    // and every index in it, see assign()
+    void load(std::istream& is)
+    {
+        auto phase = instrumentation_m.phase(Phase::load);
+        // Aligned as a memory map would be
+        std::vector<uint64_t, AlignedAllocator<uint64_t>> buffer(sizeof(SnapshotHeader)/sizeof(uint64_t));
+        auto bytes = [&buffer]() {return std::as_writable_bytes(std::span(buffer));};
+        if(!is.read(reinterpret_cast<char*>(buffer.data()), sizeof(SnapshotHeader))){
+            throw std::length_error("Snapshot is shorter than its header");
+        }
+        const auto h = DelaunayView<Float, Int>::header(bytes());
+        buffer.resize(h.size/sizeof(uint64_t));
+        if(!is.read(reinterpret_cast<char*>(buffer.data()) + sizeof(SnapshotHeader), static_cast<std::streamsize>(h.size - sizeof(SnapshotHeader)))){
+            throw std::length_error("Snapshot is truncated");
+        }
+        assign(DelaunayView<Float, Int>(bytes(), true));
+    }
+
+    bool is_ghost(const Triangle<Int>& t) const
+    {
+        return std::ranges::find(t, infinite_vertex) != std::end(t);
+    }
+
+    // Whether p lies strictly inside the circumcircle of t. For a ghost
+    // triangle the circumcircle degenerates to the open half-plane beyond its
+    // finite edge, together with the interior of that edge.
+    bool circumcircle_contains(const Triangle<Int>& t, const Vertex<Float>& p) const
+    {
+        if(is_ghost(t)){
+            auto tg = t;
+            tg.cycle(static_cast<Int>(std::ranges::find(tg, infinite_vertex) - std::begin(tg) + 1));
+            auto [ai, bi, ci] = tg.vertices();
+            auto a = this->vertices_m[ai], b = this->vertices_m[bi];
+            Float o = orientation(a, b, p);
+            if(o != 0){
+                return o > 0;
+            }
+            // p lies on the line through a and b, so it is strictly between
+            // them exactly when one of its coordinates is
+            auto between = [](const Float u, const Float v, const Float w) {return (u < v && v < w) || (w < v && v < u);};
+            return between(a.x(), p.x(), b.x()) || between(a.y(), p.y(), b.y());
+        }
+        auto [ai, bi, ci] = t.vertices();
+        return in_circle(this->vertices_m[ai], this->vertices_m[bi], this->vertices_m[ci], p) > 0;
+    }
+
+    // Whether p lies inside the counterclockwise triangle t or on its boundary
+    bool triangle_contains(const Triangle<Int>& t, const Vertex<Float>& p) const
+    {
+        auto [ai, bi, ci] = t.vertices();
+        auto a = this->vertices_m[ai], b = this->vertices_m[bi], c = this->vertices_m[ci];
+        return orientation(a, b, p) >= 0 && orientation(b, c, p) >= 0 && orientation(c, a, p) >= 0;
+    }
+
+    // The points are vertices or proxies into the vertex store
+    template<PlanarPoint A, PlanarPoint B, PlanarPoint C>
+    Float orientation(const A& a, const B& b, const C& c) const
+    {
+        instrumentation_m.count(Counter::orientation_tests);
+        return orient2d<Float>(a.x(), a.y(), b.x(), b.y(), c.x(), c.y());
+    }
+
+    // Positive if p lies inside the circle through a, b and c, in counterclockwise order
+    template<PlanarPoint A, PlanarPoint B, PlanarPoint C, PlanarPoint P>
+    Float in_circle(const A& a, const B& b, const C& c, const P& p) const
+    {
+        instrumentation_m.count(Counter::incircle_tests);
+        return incircle<Float>(a.x(), a.y(), b.x(), b.y(), c.x(), c.y(), p.x(), p.y());
+    }
+
+private:
+    // Jump-and-walk: start from whichever of the hint and roughly n^(1/3)
+    // randomly sampled triangles has a corner closest to p
+    Int walk_origin(const Vertex<Float>& p, const Int hint)
+    {
+        if(walk_start_m != WalkStart::jump_and_walk){
+            return hint;
+        }
+        Int res = hint;
+        Float d_min = std::numeric_limits<Float>::max();
+        if(!is_ghost(triangles_m[hint])){
+            d_min = dist2(Vertex<Float>(vertices_m[triangles_m[hint].front()]), p);
+        }
+        auto samples = static_cast<size_t>(std::cbrt(static_cast<double>(triangles_m.size())));
+        for(size_t i = 0; i < samples; i++){
+            Int t = static_cast<Int>(walk_rng_m() % triangles_m.size());
+            if(!triangles_m.alive(t) || is_ghost(triangles_m[t])){
+                continue;
+            }
+            Float d = dist2(Vertex<Float>(vertices_m[triangles_m[t].front()]), p);
+            if(d < d_min){
+                d_min = d;
+                res = t;
+            }
+        }
+        return res;
+    }
+
+    // Walk from triangle t to the one containing p, see DelaunayView::walk()
+    template<class Rng>
+    std::tuple<Int, Location, Int> walk(const Vertex<Float>& p, const Int t, Rng& rng, size_t& steps, size_t& tests) const
+    {
+        return view().walk(p, t, rng, steps, tests);
+    }
+
+    // The walk used while building the triangulation, from walk_origin() and
+    // counted in walk_statistics()
+    std::tuple<Int, Location, Int> walk_to(const Vertex<Float>& p, const Int hint)
+    {
+        size_t steps = 0, tests = 0;
+        auto res = walk(p, walk_origin(p, hint), walk_rng_m, steps, tests);
+        instrumentation_m.count(Counter::walks);
+        instrumentation_m.count(Counter::walk_steps, steps);
+        instrumentation_m.count(Counter::orientation_tests, tests);
+        instrumentation_m.record(Distribution::walk_steps, steps);
+        walk_statistics_m.walks++;
+        walk_statistics_m.steps += steps;
+        walk_statistics_m.max_steps = std::max(walk_statistics_m.max_steps, steps);
+        return res;
+    }
+
+    // Vertex closest to p and a triangle around it, descending from
+    // triangle t, see DelaunayView::descend()
+    std::tuple<Int, Int> descend(const Vertex<Float>& p, const Int t) const
+    {
+        return view().descend(p, t);
+    }
+
+    void check_interpolation(const size_t values, const size_t components, const size_t out, const size_t points) const
+    {
+        if(values < components*vertices_m.size()){
+            throw std::length_error("Fewer values than components per vertex");
+        }
+        if(out < components*points){
+            throw std::length_error("Output buffer holds fewer values than components per point");
+        }
+    }
+
+    // Interpolate at p, see interpolate(). Returns the triangle around p to
+    // start the next walk from.
+    template<class Value>
+    Int interpolate_at(std::span<const Value> values, const size_t components, const Vertex<Float>& p,
+                       std::span<Value> out, const Interpolation method, const Value outside, const Int hint) const
+    {
+        thread_local std::vector<std::tuple<Int, Value>> weights;
+        auto [t, location, k] = locate(p, hint);
+        weights.clear();
+        if(location == Location::outside){
+            std::ranges::fill(out, outside);
+            return t;
+        }
+        const auto& vs = triangles_m[t].vertices();
+        if(location == Location::vertex){
+            weights.emplace_back(vs[k], Value(1));
+        }else if(method == Interpolation::linear || !natural_neighbors(p, t, weights)){
+            weights.clear();
+            for(Int i = 0; i < 3; i++){
+                const Int a = vs[(i + 1) % 3], b = vs[(i + 2) % 3];
+                weights.emplace_back(vs[i], static_cast<Value>(orientation(vertices_m[a], vertices_m[b], p)));
+            }
+        }
+        Value total = 0;
+        for(const auto& [v, w] : weights){
+            total += w;
+        }
+        std::ranges::fill(out, Value(0));
+        for(const auto& [v, w] : weights){
+            for(size_t c = 0; c < components; c++){
+                out[c] += w/total*values[components*v + c];
+            }
+        }
+        return t;
+    }
+
+    // Sibson's natural neighbor weights of p, lying in the finite triangle t:
+    // the area each vertex would lose from its Voronoi cell to p, if p were
+    // inserted. The lost region is bounded by the circumcenters of the
+    // triangles around the vertex whose circumcircle contains p, and by the
+    // circumcenters of the new triangles through p and the vertex. Returns
+    // false if p lies on the hull, where its cell would be unbounded.
+    template<class Value>
+    bool natural_neighbors(const Vertex<Float>& p, const Int t, std::vector<std::tuple<Int, Value>>& weights) const
+    {
+        thread_local std::vector<Int> cavity;
+        // Boundary edges of the cavity, counterclockwise around p, and the
+        // cavity triangle on each
+        thread_local std::vector<std::tuple<Int, Int, Int>> boundary;
+        cavity.assign(1, t);
+        boundary.clear();
+        auto in_cavity = [&](const Int u) {return std::ranges::find(cavity, u) != std::end(cavity);};
+        for(size_t i = 0; i < cavity.size(); i++){
+            for(const auto& n : triangles_m[cavity[i]].neighbors()){
+                if(!in_cavity(*n) && circumcircle_contains(triangles_m[*n], p)){
+                    if(is_ghost(triangles_m[*n])){
+                        return false;
+                    }
+                    cavity.push_back(*n);
+                }
+            }
+        }
+        for(const Int c : cavity){
+            const auto& tc = triangles_m[c];
+            for(Int e = 0; e < 3; e++){
+                if(!in_cavity(*tc.neighbors()[e])){
+                    boundary.emplace_back(tc.vertices()[(e + 1) % 3], tc.vertices()[(e + 2) % 3], c);
+                }
+            }
+        }
+        // Coordinates relative to p
+        using Point = std::array<Value, 2>;
+        auto at = [&](const Int v) -> Point
+        {
+            return {static_cast<Value>(vertices_m[v].x()) - static_cast<Value>(p.x()),
+                    static_cast<Value>(vertices_m[v].y()) - static_cast<Value>(p.y())};
+        };
+        auto circumcenter = [](const Point& a, const Point& b, const Point& c) -> Point
+        {
+            Value dx = b[0] - a[0], dy = b[1] - a[1];
+            Value ex = c[0] - a[0], ey = c[1] - a[1];
+            Value bl = dx*dx + dy*dy, cl = ex*ex + ey*ey;
+            Value d = Value(0.5)/(dx*ey - dy*ex);
+            return {a[0] + (ey*bl - dy*cl)*d, a[1] + (dx*cl - ex*bl)*d};
+        };
+        const Point origin{0, 0};
+        for(const auto& [v, next, first] : boundary){
+            const Int prev = std::get<0>(*std::ranges::find_if(boundary, [v](const auto& b) {return std::get<1>(b) == v;}));
+            // Shoelace formula over the lost region, from the circumcenter of
+            // (v, next, p) through those of the cavity triangles around v,
+            // counterclockwise, to that of (prev, v, p)
+            Point start = circumcenter(origin, at(v), at(next)), last = start;
+            Value area = 0;
+            auto add = [&](const Point& q)
+            {
+                area += last[0]*q[1] - last[1]*q[0];
+                last = q;
+            };
+            Int s = first;
+            while(true){
+                const auto& ts = triangles_m[s];
+                Int i = static_cast<Int>(std::ranges::find(ts, v) - std::begin(ts));
+                add(circumcenter(at(ts.vertices()[0]), at(ts.vertices()[1]), at(ts.vertices()[2])));
+                Int u = *ts.neighbors()[(i + 1) % 3];
+                if(!in_cavity(u)){
+                    break;
+                }
+                s = u;
+            }
+            add(circumcenter(origin, at(prev), at(v)));
+            add(start);
+            weights.emplace_back(v, std::abs(area)/2);
+        }
+        return true;
+    }
+
+    // Run f(chunk, i, hint) for every point i in Hilbert order, f returning
+    // the triangle to start the next walk from. The points are shared out in
+    // chunks, one per thread and numbered from 0, which lets f keep scratch
+    // space per chunk.
+    template<class Function>
+    void for_each_query(std::span<const Vertex<Float>> points, Function&& f) const
+    {
+        if(finite_m == 0 && !points.empty()){
+            throw std::logic_error("Point location needs a triangulation with at least one triangle");
+        }
+        auto order = hilbert_order<Int>(points);
+        parallel_chunks(threads_m, order.size(), [&](const unsigned chunk, const size_t begin, const size_t end)
+            {
+                Int hint = 0;
+                for(size_t i = begin; i < end; i++){
+                    hint = f(chunk, order[i], hint);
+                }
+            });
+    }
+
+    void replace_neighbor(const Int t, const std::optional<Int> old_n, const Int new_n)
+    {
+        if(!old_n){
+            return;
+        }
+        for(auto& n : triangles_m[t].neighbors()){
+            if(n == old_n){
+                n = new_n;
+            }
+        }
+    }
+
+    // Split triangle t into three by the vertex p, t keeps its slot
+    std::tuple<Int, Int, Int> insert(const Int p, const Int t)
+    {
+        auto [a, b, c] = triangles_m[t].vertices();
+        auto [na, nb, nc] = triangles_m[t].neighbors();
+        // Splitting a ghost triangle leaves one finite triangle and two ghosts
+        finite_delta_m += is_ghost(triangles_m[t]) ? Int(1) : Int(2);
+        Int t1 = t, t2 = triangles_m.allocate({a, p, c}), t3 = triangles_m.allocate({a, b, p});
+        instrumentation_m.count(Counter::triangle_allocations, 2);
+        triangles_m[t1] = {p, b, c};
+        triangles_m[t1].neighbors() = {na, t2, t3};
+        triangles_m[t2].neighbors() = {t1, nb, t3};
+        triangles_m[t3].neighbors() = {t1, t2, nc};
+        if(nb){
+            replace_neighbor(*nb, t, t2);
+        }
+        if(nc){
+            replace_neighbor(*nc, t, t3);
+        }
+        return {t1, t2, t3};
+    }
+
+    // Split triangle t, and its neighbor across edge e, by the vertex p lying on e
+    std::tuple<Int, Int, Int, Int> insert(const Int p, const Int t, const Int e)
+    {
+        triangles_m[t].cycle(e);
+        Int u = *triangles_m[t].neighbors().front();
+        auto& tu = triangles_m[u];
+        tu.cycle(static_cast<Int>(std::distance(std::begin(tu.neighbors()), std::ranges::find(tu.neighbors(), t))));
+
+        auto [a, b, c] = triangles_m[t].vertices();
+        auto [na, nb, nc] = triangles_m[t].neighbors();
+        auto d = triangles_m[u].front();
+        auto [nd, nuc, nub] = triangles_m[u].neighbors();
+
+        finite_delta_m += static_cast<Int>(!is_ghost(triangles_m[t])) + static_cast<Int>(!is_ghost(triangles_m[u]));
+        Int t1 = t, u1 = u, t2 = triangles_m.allocate({a, p, c}), u2 = triangles_m.allocate({d, p, b});
+        instrumentation_m.count(Counter::triangle_allocations, 2);
+        triangles_m[t1] = {a, b, p};
+        triangles_m[t1].neighbors() = {u2, t2, nc};
+        triangles_m[u1] = {d, c, p};
+        triangles_m[u1].neighbors() = {t2, u2, nub};
+        triangles_m[t2].neighbors() = {u1, nb, t1};
+        triangles_m[u2].neighbors() = {t1, nuc, u1};
+        if(nb){
+            replace_neighbor(*nb, t, t2);
+        }
+        if(nuc){
+            replace_neighbor(*nuc, u, u2);
+        }
+        return {t1, t2, u1, u2};
+    }
+
+
+    // Flip the edge shared by t and u in place. Both keep their slots, and the
+    // vertex of t opposite the shared edge is placed first in both of them.
+    std::tuple<Int, Int> flip(const Int t, const Int u)
+    {
+        instrumentation_m.count(Counter::flips);
+        auto& tt = triangles_m[t];
+        auto& tu = triangles_m[u];
+        tt.cycle(static_cast<Int>(std::ranges::find(tt.neighbors(), u) - std::begin(tt.neighbors())));
+        tu.cycle(static_cast<Int>(std::ranges::find(tu.neighbors(), t) - std::begin(tu.neighbors())));
+
+        auto [p, a, b] = tt.vertices();
+        auto d = tu.front();
+        // Two ghosts flip into a finite triangle and a ghost
+        finite_delta_m += is_ghost(tt) && is_ghost(tu);
+        auto [nt0, nt1, nt2] = tt.neighbors();
+        auto [nu0, nu1, nu2] = tu.neighbors();
+        tt = {p, a, d};
+        tt.neighbors() = {nu1, u, nt2};
+        tu = {p, d, b};
+        tu.neighbors() = {nu2, nt1, t};
+        if(nu1){
+            replace_neighbor(*nu1, u, t);
+        }
+        if(nt1){
+            replace_neighbor(*nt1, t, u);
+        }
+        return {t, u};
+    }
+
+    // Lawson legalization: pop triangles containing p off flip_stack_m and
+    // flip the edge opposite p while p lies inside the circumcircle of the
+    // triangle across it. Both triangles of a flip contain p and are pushed.
+    size_t legalize(const Int p)
+    {
+        size_t flips = 0;
+        while(!flip_stack_m.empty()){
+            Int t = flip_stack_m.back();
+            flip_stack_m.pop_back();
+            auto& tt = triangles_m[t];
+            auto it = std::ranges::find(tt, p);
+            if(it == std::end(tt)){
+                continue;
+            }
+            tt.cycle(static_cast<Int>(it - std::begin(tt)));
+            Int u = *tt.neighbors().front();
+            if(circumcircle_contains(triangles_m[u], vertices_m[p])){
+                flip(t, u);
+                flip_stack_m.push_back(t);
+                flip_stack_m.push_back(u);
+                flips++;
+            }
+        }
+        return flips;
+    }
+
+    // Insert vertex p, located by walking from hint, and legalize the new
+    // edges. Returns a triangle containing p, or the triangle holding an
+    // earlier copy of it.
+    Int insert_vertex(const Int p, const Int hint)
+    {
+        auto timer = instrumentation_m.time(Distribution::insertion_nanoseconds);
+        auto [t, location, i] = walk_to(vertices_m[p], hint);
+        if(location == Location::vertex){
+            return t;
+        }
+        flip_stack_m.clear();
+        if(location == Location::edge){
+            auto [t1, t2, t3, t4] = insert(p, t, i);
+            flip_stack_m.insert(std::end(flip_stack_m), {t1, t2, t3, t4});
+        }else{
+            auto [t1, t2, t3] = insert(p, t);
+            flip_stack_m.insert(std::end(flip_stack_m), {t1, t2, t3});
+        }
+        size_t flips = legalize(p);
+        instrumentation_m.count(Counter::insertions);
+        instrumentation_m.record(Distribution::flips_per_insertion, flips);
+        instrumentation_m.record(Distribution::cavity_size, (location == Location::edge ? 2 : 1) + flips);
+        flip_statistics_m.insertions++;
+        flip_statistics_m.flips += flips;
+        flip_statistics_m.max_flips = std::max(flip_statistics_m.max_flips, flips);
+        return t;
+    }
+
+    // One pass over the neighbor links of the finite triangles: an edge is
+    // taken from the lower numbered of its two triangles, or from its only
+    // finite one on the hull
+    void collect_edges(std::vector<Edge<Int>>& res) const
+    {
+        res.clear();
+        res.reserve(3*size_t(finite_m)/2 + (triangles_m.size() - finite_m));
+        for(Int t = 0; t < finite_m; t++){
+            const auto& tt = triangles_m[t];
+            for(Int e = 0; e < 3; e++){
+                const Int u = *tt.neighbors()[e];
+                if(u >= finite_m){
+                    res.emplace_back(tt.vertices()[(e + 1) % 3], tt.vertices()[(e + 2) % 3], t, std::nullopt);
+                }else if(t < u){
+                    res.emplace_back(tt.vertices()[(e + 1) % 3], tt.vertices()[(e + 2) % 3], t, u);
+                }
+            }
+        }
+    }
+
+    void update_vertex_triangles(const Int t)
+    {
+        if(vertex_triangles_m.size() != vertices_m.size()){
+            return;
+        }
+        for(const Int v : triangles_m[t]){
+            if(v != infinite_vertex){
+                vertex_triangles_m[v] = t;
+            }
+        }
+    }
+
+    // A triangle around vertex v, or nothing if v is not part of the
+    // triangulation, e.g. a duplicate point or a removed vertex
+    std::optional<Int> vertex_triangle(const Int v)
+    {
+        if(vertex_triangles_m.size() != vertices_m.size()){
+            vertex_triangles_m.assign(vertices_m.size(), OptionalIndex<Int>::none);
+            for(Int t = 0; t < triangles_m.size(); t++){
+                update_vertex_triangles(t);
+            }
+        }
+        Int t = vertex_triangles_m[v];
+        if(t < triangles_m.size() && std::ranges::find(triangles_m[t], v) != std::end(triangles_m[t])){
+            return t;
+        }
+        if(finite_m == 0){
+            return std::nullopt;
+        }
+        auto [s, location, i] = walk_to(vertices_m[v], t < triangles_m.size() ? t : 0);
+        if(location != Location::vertex || triangles_m[s].vertices()[i] != v){
+            return std::nullopt;
+        }
+        vertex_triangles_m[v] = s;
+        return s;
+    }
+
+    // The triangles around vertex v in counterclockwise order starting from
+    // t, star_m[j] having the corners v, link_m[j] and link_m[j + 1]
+    void collect_star(const Int v, const Int t)
+    {
+        star_m.clear();
+        link_m.clear();
+        Int s = t;
+        do{
+            const auto& ts = triangles_m[s];
+            Int k = static_cast<Int>(std::ranges::find(ts, v) - std::begin(ts));
+            star_m.push_back(s);
+            link_m.push_back(ts.vertices()[(k + 1) % 3]);
+            s = *ts.neighbors()[(k + 1) % 3];
+        }while(s != t);
+    }
+
+    // Lawson legalization of arbitrary edges: pop pairs of triangles off
+    // edge_stack_m and flip their shared edge while it is not locally
+    // Delaunay. Hull edges are left alone, as are pairs that a flip has
+    // separated in the meantime.
+    size_t legalize_edges()
+    {
+        size_t flips = 0;
+        while(!edge_stack_m.empty()){
+            auto [t, u] = edge_stack_m.back();
+            edge_stack_m.pop_back();
+            const auto& nt = triangles_m[t].neighbors();
+            if(std::ranges::find(nt, u) == std::end(nt) || is_ghost(triangles_m[t]) || is_ghost(triangles_m[u])){
+                continue;
+            }
+            const auto& tu = triangles_m[u];
+            Int d = tu.vertices()[static_cast<size_t>(std::ranges::find(tu.neighbors(), t) - std::begin(tu.neighbors()))];
+            if(circumcircle_contains(triangles_m[t], vertices_m[d])){
+                flip(t, u);
+                mark_changed(std::array<Int, 2>{t, u});
+                for(const Int s : {t, u}){
+                    update_vertex_triangles(s);
+                    for(const auto& n : triangles_m[s].neighbors()){
+                        if(n && *n != t && *n != u){
+                            edge_stack_m.emplace_back(s, *n);
+                        }
+                    }
+                }
+                flips++;
+            }
+        }
+        return flips;
+    }
+
+    void mark_changed(std::span<const Int> slots)
+    {
+        edges_valid_m = false;
+        adjacency_valid_m = false;
+        if(circumcenters_valid_m){
+            changed_m.insert(std::end(changed_m), std::begin(slots), std::end(slots));
+        }
+    }
+
+    // Drop everything derived from the triangulation
+    void invalidate_derived()
+    {
+        circumcenters_valid_m = false;
+        cells_valid_m = false;
+        changed_m.clear();
+        edges_valid_m = false;
+        adjacency_valid_m = false;
+    }
+
+    // Circumcenters of the triangles in slots, gathered a block at a time
+    // for the batched kernel
+    void compute_circumcenters(std::span<const Int> slots) requires Floating<Float>
+    {
+        constexpr size_t block = 256;
+        std::array<Float, block> ax, ay, bx, by, cx, cy, ox, oy;
+        for(size_t i = 0; i < slots.size(); i += block){
+            const size_t m = std::min(block, slots.size() - i);
+            for(size_t k = 0; k < m; k++){
+                auto [a, b, c] = triangles_m[slots[i + k]].vertices();
+                ax[k] = vertices_m[a].x();
+                ay[k] = vertices_m[a].y();
+                bx[k] = vertices_m[b].x();
+                by[k] = vertices_m[b].y();
+                cx[k] = vertices_m[c].x();
+                cy[k] = vertices_m[c].y();
+            }
+            circumcenter_batch(BatchPoints<Float>(ax.data(), ay.data()), BatchPoints<Float>(bx.data(), by.data()),
+                BatchPoints<Float>(cx.data(), cy.data()), m, ox.data(), oy.data());
+            for(size_t k = 0; k < m; k++){
+                voronoi_m.x_m[slots[i + k]] = ox[k];
+                voronoi_m.y_m[slots[i + k]] = oy[k];
+            }
+        }
+    }
+
+    // Gather the cells of the Voronoi diagram from the circumcenters. Cells of
+    // hull vertices, and cells with a circumcenter outside the box, are cut
+    // out of the box by the bisectors with every neighbor instead. The cells
+    // of vertices not marked stale are copied from old, the cells built
+    // before the edits with old_finite circumcenters, of which old keeps
+    // only the clipping vertices: their triangles, and so their neighbors,
+    // are the same.
+    void build_cells(const std::array<Float, 4>& box, const VoronoiDiagram<Float, Int>& old, const Int old_finite,
+        const std::vector<bool>& stale) requires Floating<Float>
+    {
+        auto& vd = voronoi_m;
+        const size_t n = vertices_m.size();
+        std::vector<Int> around(n, OptionalIndex<Int>::none);
+        for(Int t = 0; t < triangles_m.size(); t++){
+            for(const Int v : triangles_m[t]){
+                if(v != infinite_vertex){
+                    around[v] = t;
+                }
+            }
+        }
+        auto [xmin, ymin, xmax, ymax] = box;
+        auto in_box = [&](const Int t)
+        {
+            return vd.x_m[t] >= xmin && vd.x_m[t] <= xmax && vd.y_m[t] >= ymin && vd.y_m[t] <= ymax;
+        };
+        using Point = std::array<Float, 2>;
+        std::vector<Point> poly, clipped;
+        vd.offsets_m.assign(n + 1, 0);
+        vd.indices_m.clear();
+        for(size_t v = 0; v < n; v++){
+            if(around[v] != OptionalIndex<Int>::none && v < old.size() && v < stale.size() && !stale[v]){
+                for(const Int i : old.cell(v)){
+                    if(i < old_finite){
+                        vd.indices_m.push_back(i);
+                    }else{
+                        vd.indices_m.push_back(static_cast<Int>(vd.x_m.size()));
+                        vd.x_m.push_back(old.x_m[i - old_finite]);
+                        vd.y_m.push_back(old.y_m[i - old_finite]);
+                    }
+                }
+            }else if(around[v] != OptionalIndex<Int>::none){
+                collect_star(static_cast<Int>(v), around[v]);
+                if(std::ranges::find(link_m, infinite_vertex) == std::end(link_m) && std::ranges::all_of(star_m, in_box)){
+                    vd.indices_m.insert(std::end(vd.indices_m), std::begin(star_m), std::end(star_m));
+                }else{
+                    poly = {{xmin, ymin}, {xmax, ymin}, {xmax, ymax}, {xmin, ymax}};
+                    const Point pv{vertices_m[v].x(), vertices_m[v].y()};
+                    for(const Int w : link_m){
+                        if(w == infinite_vertex){
+                            continue;
+                        }
+                        // Keep the side of the bisector closer to v
+                        const Point pw{vertices_m[w].x(), vertices_m[w].y()};
+                        const Point normal{pw[0] - pv[0], pw[1] - pv[1]};
+                        const Point mid{(pv[0] + pw[0])/2, (pv[1] + pw[1])/2};
+                        auto side = [&](const Point& q) {return (q[0] - mid[0])*normal[0] + (q[1] - mid[1])*normal[1];};
+                        clipped.clear();
+                        for(size_t i = 0; i < poly.size(); i++){
+                            const Point& a = poly[i];
+                            const Point& b = poly[(i + 1) % poly.size()];
+                            const Float fa = side(a), fb = side(b);
+                            if(fa <= 0){
+                                clipped.push_back(a);
+                            }
+                            if((fa < 0 && fb > 0) || (fa > 0 && fb < 0)){
+                                const Float r = fa/(fa - fb);
+                                clipped.push_back({a[0] + r*(b[0] - a[0]), a[1] + r*(b[1] - a[1])});
+                            }
+                        }
+                        std::swap(poly, clipped);
+                    }
+                    for(const auto& [x, y] : poly){
+                        vd.indices_m.push_back(static_cast<Int>(vd.x_m.size()));
+                        vd.x_m.push_back(x);
+                        vd.y_m.push_back(y);
+                    }
+                }
+            }
+            vd.offsets_m[v + 1] = vd.indices_m.size();
+        }
+    }
+
+    void swap_triangles(const Int t, const Int u)
+    {
+        triangles_m.swap(t, u);
+        update_vertex_triangles(t);
+        update_vertex_triangles(u);
+    }
+
+    // Bring back the finite-first triangle order after a local change that
+    // leaves finite finite triangles. Every slot whose triangle changed must
+    // be in touched, so the cost is that of the change.
+    void restore_order(std::vector<Int>& touched, const Int finite)
+    {
+        for(Int t = std::min(finite, finite_m); t < std::max(finite, finite_m); t++){
+            touched.push_back(t);
+        }
+        std::ranges::sort(touched);
+        touched.erase(std::unique(std::begin(touched), std::end(touched)), std::end(touched));
+        mark_changed(touched);
+        std::vector<Int> ghosts, finites;
+        for(const Int t : touched){
+            if(t >= triangles_m.size()){
+                continue;
+            }
+            const bool ghost = is_ghost(triangles_m[t]);
+            if(t < finite && ghost){
+                ghosts.push_back(t);
+            }else if(t >= finite && !ghost){
+                finites.push_back(t);
+            }
+        }
+        if(ghosts.size() != finites.size()){
+            throw std::logic_error("Finite triangle count is out of step with the triangles");
+        }
+        for(size_t i = 0; i < ghosts.size(); i++){
+            swap_triangles(ghosts[i], finites[i]);
+        }
+        finite_m = finite;
+    }
+
+    // Remove vertex v, t being a triangle around it. The polygon formed by
+    // the neighbors of v is triangulated by clipping ears, the one whose
+    // circumcircle v lies deepest inside first (lowest power of v), and the
+    // new edges are legalized. The neighbors of a hull vertex form an open
+    // chain instead, and what is left of it once no ear remains becomes hull.
+    // Returns false, leaving the triangulation as it was, if no finite
+    // triangle would be left.
+    bool remove_vertex(const Int v, const Int t)
+    {
+        collect_star(v, t);
+        const size_t k = star_m.size();
+        instrumentation_m.count(Counter::removals);
+        instrumentation_m.record(Distribution::cavity_size, k);
+        std::vector<Int> poly;
+        auto inf = std::ranges::find(link_m, infinite_vertex);
+        const bool hull = inf != std::end(link_m);
+        if(hull){
+            poly.insert(std::end(poly), inf + 1, std::end(link_m));
+            poly.insert(std::end(poly), std::begin(link_m), inf);
+        }else{
+            poly = link_m;
+        }
+        const size_t q = poly.size();
+        std::vector<size_t> prev(q), next(q);
+        for(size_t i = 0; i < q; i++){
+            prev[i] = (i + q - 1) % q;
+            next[i] = (i + 1) % q;
+        }
+        // Ears are queued by the power of v, and requeued with a new stamp
+        // when a neighbor is clipped
+        using Ear = std::tuple<Float, size_t, size_t>;
+        std::priority_queue<Ear, std::vector<Ear>, std::greater<>> ears;
+        std::vector<size_t> stamp(q, 0);
+        const Vertex<Float> pv = vertices_m[v];
+        auto queue_ear = [&](const size_t i)
+        {
+            stamp[i]++;
+            if(hull && (i == 0 || i == q - 1)){
+                return;
+            }
+            auto a = vertices_m[poly[prev[i]]], b = vertices_m[poly[i]], c = vertices_m[poly[next[i]]];
+            Float o = orientation(a, b, c);
+            if(o <= 0 || orientation(a, c, pv) < 0){
+                return;
+            }
+            ears.emplace(-in_circle(a, b, c, pv)/o, stamp[i], i);
+        };
+        for(size_t i = 0; i < q; i++){
+            queue_ear(i);
+        }
+        std::vector<Triangle<Int>> created;
+        size_t left = q, last = 0;
+        while(!ears.empty() && (hull || left > 3)){
+            auto [power, s, i] = ears.top();
+            ears.pop();
+            if(s != stamp[i]){
+                continue;
+            }
+            created.push_back({poly[prev[i]], poly[i], poly[next[i]]});
+            next[prev[i]] = next[i];
+            prev[next[i]] = prev[i];
+            stamp[i]++;
+            left--;
+            last = next[i];
+            queue_ear(prev[i]);
+            queue_ear(next[i]);
+        }
+        if(hull){
+            for(size_t i = 0; i != q - 1; i = next[i]){
+                created.push_back({poly[i], poly[next[i]], infinite_vertex});
+            }
+        }else{
+            if(left != 3){
+                throw std::logic_error("No ear left in the polygon around a removed vertex");
+            }
+            created.push_back({poly[prev[last]], poly[last], poly[next[last]]});
+        }
+        auto finite = [this](const Triangle<Int>& tr) {return !is_ghost(tr);};
+        const auto finite_before = static_cast<Int>(std::ranges::count_if(star_m, [&](const Int s) {return finite(triangles_m[s]);}));
+        const auto finite_after = static_cast<Int>(std::ranges::count_if(created, finite));
+        if(finite_m - finite_before + finite_after == 0){
+            return false;
+        }
+
+        // The edges of the polygon, counterclockwise around v, and the
+        // triangle beyond each
+        std::vector<std::tuple<Int, Int, Int>> outer(k);
+        for(size_t j = 0; j < k; j++){
+            const auto& ts = triangles_m[star_m[j]];
+            outer[j] = {link_m[j], link_m[(j + 1) % k], *ts.neighbors()[static_cast<size_t>(std::ranges::find(ts, v) - std::begin(ts))]};
+        }
+        std::ranges::sort(outer);
+
+        // The new triangles take over the slots of the star
+        std::vector<Int> slots(created.size());
+        for(size_t i = 0; i < created.size(); i++){
+            if(i < k){
+                slots[i] = star_m[i];
+                triangles_m[slots[i]] = created[i];
+            }else{
+                slots[i] = triangles_m.allocate(created[i]);
+            }
+        }
+        instrumentation_m.count(Counter::triangle_allocations, created.size() - std::min(k, created.size()));
+        // Edges between two new triangles, by their lower and higher vertex
+        std::vector<std::tuple<Int, Int, Int, Int>> inner;
+        for(size_t i = 0; i < created.size(); i++){
+            const Int s = slots[i];
+            for(Int e = 0; e < 3; e++){
+                Int a = created[i].vertices()[(e + 1) % 3], b = created[i].vertices()[(e + 2) % 3];
+                auto it = std::ranges::lower_bound(outer, std::tuple<Int, Int, Int>(a, b, 0));
+                if(it != std::end(outer) && std::get<0>(*it) == a && std::get<1>(*it) == b){
+                    Int o = std::get<2>(*it);
+                    auto& to = triangles_m[o];
+                    auto f = static_cast<size_t>(std::ranges::find_if(to, [a, b](const Int w) {return w != a && w != b;}) - std::begin(to));
+                    triangles_m[s].neighbors()[e] = o;
+                    to.neighbors()[f] = s;
+                }else{
+                    inner.emplace_back(std::min(a, b), std::max(a, b), s, e);
+                }
+            }
+        }
+        std::ranges::sort(inner);
+        for(size_t i = 0; i + 1 < inner.size(); i += 2){
+            auto [a, b, s, e] = inner[i];
+            auto [c, d, u, f] = inner[i + 1];
+            if(a != c || b != d){
+                throw std::logic_error("Unmatched edge in the polygon around a removed vertex");
+            }
+            triangles_m[s].neighbors()[e] = u;
+            triangles_m[u].neighbors()[f] = s;
+        }
+
+        edge_stack_m.clear();
+        for(const Int s : slots){
+            update_vertex_triangles(s);
+            for(const auto& n : triangles_m[s].neighbors()){
+                edge_stack_m.emplace_back(s, *n);
+            }
+        }
+        legalize_edges();
+
+        std::vector<Int> touched = slots;
+        std::vector<Int> unused(std::begin(star_m) + static_cast<std::ptrdiff_t>(std::min(k, created.size())), std::end(star_m));
+        for(const Int s : unused){
+            triangles_m[s].neighbors() = {};
+        }
+        std::ranges::sort(unused, std::greater<>());
+        instrumentation_m.count(Counter::triangle_releases, unused.size());
+        for(const Int s : unused){
+            triangles_m.erase(s);
+            if(s < triangles_m.size()){
+                update_vertex_triangles(s);
+                touched.push_back(s);
+            }
+        }
+        restore_order(touched, finite_m - finite_before + finite_after);
+        return true;
+    }
+
+    // The first three points that are not collinear, in counterclockwise order
+    std::optional<Triangle<Int>> initial_triangle(const VertexStore<Float>& points) const
+    {
+        const size_t n = points.size();
+        size_t b = 1;
+        while(b < n && points[b] == points[0]){
+            b++;
+        }
+        if(b >= n){
+            return {};
+        }
+        size_t c = n;
+        if constexpr(std::floating_point<Float>){
+            // Scan in blocks with the batched predicate, nearly collinear
+            // inputs can go a long way before finding the third corner
+            constexpr size_t block = 256;
+            std::array<Float, block> o;
+            const Float* x = points.coordinates(0).data();
+            const Float* y = points.coordinates(1).data();
+            for(size_t i = b; i < n && c == n; i += block){
+                const size_t m = std::min(block, n - i);
+                orient2d_batch<Float>({x, y, 0}, {x + b, y + b, 0}, {x + i, y + i}, m, o.data());
+                instrumentation_m.count(Counter::orientation_tests, m);
+                auto nonzero = std::find_if(std::begin(o), std::begin(o) + m, [](const Float v) {return v != 0;});
+                if(nonzero != std::begin(o) + m){
+                    c = i + static_cast<size_t>(nonzero - std::begin(o));
+                }
+            }
+        }else{
+            for(c = b; c < n && orientation(points[0], points[b], points[c]) == 0; c++){
+            }
+        }
+        if(c == n){
+            return {};
+        }
+        if(orientation(points[0], points[b], points[c]) < 0){
+            std::swap(b, c);
+        }
+        return Triangle<Int>{Int(0), static_cast<Int>(b), static_cast<Int>(c)};
+    }
+
+    // A vertex with its coordinates, so the divide and conquer recursion
+    // partitions contiguous data rather than indices into the vertices
+    struct Site{
+        Float x;
+        Float y;
+        Int v;
+    };
+
+    // Lexicographic order in a frame with the given axis first: (x, y) for
+    // axis 0, and (y, -x) for axis 1, which is the plane turned a quarter
+    // clockwise so orientations are kept
+    static bool precedes(const int axis, const Float ax, const Float ay, const Float bx, const Float by)
+    {
+        if(axis == 0){
+            return ax < bx || (ax == bx && ay < by);
+        }
+        return ay < by || (ay == by && ax > bx);
+    }
+
+    bool precedes(const int axis, const Int a, const Int b) const
+    {
+        auto va = vertices_m[a], vb = vertices_m[b];
+        return precedes(axis, va.x(), va.y(), vb.x(), vb.y());
     }
 
-    std::vector<Triangle<Float>> triangles_coord() const
+    // Hull edges of a triangulation in the frame of axis, found by walking
+    // its convex hull counterclockwise from the hull edge e: the
+    // counterclockwise one out of the first vertex and the clockwise one out
+    // of the last
+    std::tuple<Int, Int> hull_extremes(const QuadEdges<Int>& mesh, const Int e, const int axis) const
     {
-
-        std::vector<Triangle<Float>> res;
-        for(auto t : triangles_m){
-            auto [ai, bi, ci] = t.vertices();
-            res.push_back({vertices_m[ai], vertices_m[bi], vertices_m[ci]});
+        Int first = e, last = e;
+        for(Int f = mesh.rprev(e); f != e; f = mesh.rprev(f)){
+            if(precedes(axis, mesh.org(f), mesh.org(first))){
+                first = f;
+            }
+            if(precedes(axis, mesh.dest(last), mesh.dest(f))){
+                last = f;
+            }
         }
-        return res;
+        return {first, mesh.sym(last)};
     }
 
-    bool circumcircle_contains(const Triangle<Int>& t, const Vertex<Float>& p)
+    // Guibas-Stolfi recursion on the vertices s[begin, end), cutting at the
+    // median along alternating axes (Dwyer), which keeps the parts square
+    // and the merges short. Returns, in the frame of axis, the
+    // counterclockwise convex hull edge out of the first vertex and the
+    // clockwise one out of the last.
+    std::tuple<Int, Int> divide_and_conquer(QuadEdges<Int>& mesh, std::vector<Site>& s, const size_t begin, const size_t end, const int axis)
     {
-        auto [ai, bi, ci] = t.vertices();
-        Vertex<Float> a = this->vertices_m[ai], b = this->vertices_m[bi], c = this->vertices_m[ci];
-        Float ax = *a.begin(), ay = *(++a.begin());
-        Float bx = *b.begin(), by = *(++b.begin());
-        Float cx = *c.begin(), cy = *(++c.begin());
-        Float px = *p.begin(), py = *(++p.begin());
-        return    (ax - px)*(by - py)*((cx - px)*(cx - px) + (cy - py)*(cy - py))
-                + (cx - px)*(ay - ay)*((bx - px)*(bx - px) + (by - py)*(by - py))
-                + (bx - px)*(cy - ay)*((ax - px)*(ax - px) + (ay - py)*(ay - py))
-                - (cx - px)*(by - ay)*((ax - px)*(ax - px) + (ay - py)*(ay - py))
-                - (ax - px)*(cy - ay)*((bx - px)*(bx - px) + (by - py)*(by - py))
-                - (bx - px)*(ay - ay)*((cx - px)*(cx - px) + (cy - py)*(cy - py))
-                 < 0;
-    }
-
-    std::tuple<Float, Float> triangle_edge_checks(const Triangle<Int>& t, const Vertex<Float>& p)
+        auto ccw = [this](const Site& a, const Site& b, const Site& c)
+        {
+            return orientation(Vertex<Float>{a.x, a.y}, Vertex<Float>{b.x, b.y}, Vertex<Float>{c.x, c.y}) > 0;
+        };
+        auto before = [axis](const Site& a, const Site& b) {return precedes(axis, a.x, a.y, b.x, b.y);};
+        auto at = [&s](const size_t i) {return std::begin(s) + static_cast<std::ptrdiff_t>(i);};
+
+        if(end - begin <= 3){
+            std::sort(at(begin), at(end), before);
+        }
+        if(end - begin == 2){
+            Int a = mesh.make_edge(s[begin].v, s[begin + 1].v);
+            return {a, mesh.sym(a)};
+        }
+        if(end - begin == 3){
+            Int a = mesh.make_edge(s[begin].v, s[begin + 1].v);
+            Int b = mesh.make_edge(s[begin + 1].v, s[begin + 2].v);
+            mesh.splice(mesh.sym(a), b);
+            if(ccw(s[begin], s[begin + 1], s[begin + 2])){
+                mesh.connect(b, a);
+                return {a, mesh.sym(b)};
+            }else if(ccw(s[begin], s[begin + 2], s[begin + 1])){
+                Int c = mesh.connect(b, a);
+                return {mesh.sym(c), c};
+            }
+            return {a, mesh.sym(b)};
+        }
+
+        size_t mid = begin + (end - begin)/2;
+        std::nth_element(at(begin), at(mid), at(end), before);
+        auto [ldo, ldi] = hull_extremes(mesh, std::get<0>(divide_and_conquer(mesh, s, begin, mid, 1 - axis)), axis);
+        auto [rdi, rdo] = hull_extremes(mesh, std::get<0>(divide_and_conquer(mesh, s, mid, end, 1 - axis)), axis);
+        return merge(mesh, ldo, ldi, rdi, rdo);
+    }
+
+    // Merge step of the Guibas-Stolfi recursion, joining the triangulation
+    // with hull edges ldo, ldi to the one on its right with hull edges rdi, rdo
+    std::tuple<Int, Int> merge(QuadEdges<Int>& mesh, Int ldo, Int ldi, Int rdi, Int rdo)
     {
-        auto [ai, bi, ci] = t.vertices();
-        Vertex<Float> a = this->vertices_m[ai], b = this->vertices_m[bi], c = this->vertices_m[ci];
-        Float ax = *a.begin(), ay = *(a.begin() + 1);
-        Float bx = *b.begin(), by = *(b.begin() + 1);
-        Float cx = *c.begin(), cy = *(c.begin() + 1);
-        Float px = *p.begin(), py = *(p.begin() + 1);
+        auto ccw = [this](const Int a, const Int b, const Int c)
+        {
+            return orientation(vertices_m[a], vertices_m[b], vertices_m[c]) > 0;
+        };
+        auto left_of = [&](const Int x, const Int e)
+        {
+            return ccw(x, mesh.org(e), mesh.dest(e));
+        };
+        auto right_of = [&](const Int x, const Int e)
+        {
+            return ccw(x, mesh.dest(e), mesh.org(e));
+        };
+        // The candidate after the last one is an end of the base edge, which
+        // is decided here rather than by an exact test of a zero determinant
+        auto in_circle_of = [this](const Int a, const Int b, const Int c, const Int d)
+        {
+            return d != a && d != b && d != c && in_circle(vertices_m[a], vertices_m[b], vertices_m[c], vertices_m[d]) > 0;
+        };
 
-        Float det12 = (bx - ax)*(cy - ay) - (by - ay)*(cx - ax);
-        Float detp1 = (px)*(by - ay) - (py)*(bx - ax);
-        Float detp2 = (px)*(cy - ay) - (py)*(cx - ax);
-        Float det01 = (ax)*(by - ay) - (ay)*(bx - ax);
-        Float det02 = (ax)*(cy - ay) - (ay)*(cx - ax);
+        // Lower common tangent of the two halves
+        while(true){
+            if(left_of(mesh.org(rdi), ldi)){
+                ldi = mesh.lnext(ldi);
+            }else if(right_of(mesh.org(ldi), rdi)){
+                rdi = mesh.rprev(rdi);
+            }else{
+                break;
+            }
+        }
+        Int basel = mesh.connect(mesh.sym(rdi), ldi);
+        if(mesh.org(ldi) == mesh.org(ldo)){
+            ldo = mesh.sym(basel);
+        }
+        if(mesh.org(rdi) == mesh.org(rdo)){
+            rdo = basel;
+        }
 
-        Float x = (detp2 - det02)/det12;
-        float y = -(detp1 - det01)/det12;
-        return {x, y};
+        // Rising bubble: zip the halves together from the base edge upwards
+        auto valid = [&](const Int e)
+        {
+            return right_of(mesh.dest(e), basel);
+        };
+        // Each candidate is tested once, and again only if edges were removed
+        // in front of it
+        while(true){
+            Int lcand = mesh.onext(mesh.sym(basel));
+            bool lvalid = valid(lcand);
+            if(lvalid && in_circle_of(mesh.dest(basel), mesh.org(basel), mesh.dest(lcand), mesh.dest(mesh.onext(lcand)))){
+                do{
+                    Int t = mesh.onext(lcand);
+                    mesh.remove(lcand);
+                    lcand = t;
+                }while(in_circle_of(mesh.dest(basel), mesh.org(basel), mesh.dest(lcand), mesh.dest(mesh.onext(lcand))));
+                lvalid = valid(lcand);
+            }
+            Int rcand = mesh.oprev(basel);
+            bool rvalid = valid(rcand);
+            if(rvalid && in_circle_of(mesh.dest(basel), mesh.org(basel), mesh.dest(rcand), mesh.dest(mesh.oprev(rcand)))){
+                do{
+                    Int t = mesh.oprev(rcand);
+                    mesh.remove(rcand);
+                    rcand = t;
+                }while(in_circle_of(mesh.dest(basel), mesh.org(basel), mesh.dest(rcand), mesh.dest(mesh.oprev(rcand))));
+                rvalid = valid(rcand);
+            }
+            if(!lvalid && !rvalid){
+                break;
+            }
+            if(!lvalid ||
+               (rvalid && in_circle_of(mesh.dest(lcand), mesh.org(lcand), mesh.org(rcand), mesh.dest(rcand)))){
+                basel = mesh.connect(rcand, mesh.sym(basel));
+            }else{
+                basel = mesh.connect(mesh.sym(basel), mesh.sym(lcand));
+            }
+        }
+        return {ldo, rdo};
     }
 
-    bool triangle_contains(const Triangle<Int>& t, const Vertex<Float>& p)
+    // Fill triangles_m with the faces of mesh, the finite triangles first and
+    // a ghost triangle for every convex hull edge after them. Each triangle is
+    // numbered by its lowest edge, and the edges are split between threads.
+    void from_quad_edges(const QuadEdges<Int>& mesh, const unsigned threads)
     {
-        auto [a, b] = triangle_edge_checks(t, p);
-        std::cout << "a = " << a << ", b = " << b << "\n";
-        return (std::abs(a) < 1e-10 || a >= 0) && (std::abs(b) < 1e-10 || b >= 0)
-            && (std::abs(a + b - 1) < 1e-10 || a + b < 1);
+        constexpr Int none = std::numeric_limits<Int>::max();
+        const size_t m = mesh.size()/2;
+        std::vector<Int> face(mesh.size(), none);
+        std::vector<Int> triangle_count(threads + 1, 0), hull_count(threads + 1, 0);
+        // Faces of three edges are tested once, from their lowest edge. Only
+        // a counterclockwise one is a triangle, the outer face of three
+        // points is clockwise.
+        std::vector<uint8_t> counterclockwise(mesh.size(), false);
+        parallel_chunks(threads, m, [&](const unsigned, const size_t begin, const size_t end)
+            {
+                for(Int e = static_cast<Int>(2*begin); e < 2*end; e += 2){
+                    Int e1 = mesh.lnext(e), e2 = mesh.lnext(e1);
+                    if(!mesh.deleted(e) && mesh.lnext(e2) == e && e < e1 && e < e2){
+                        counterclockwise[e] = orientation(vertices_m[mesh.org(e)], vertices_m[mesh.org(e1)], vertices_m[mesh.org(e2)]) > 0;
+                    }
+                }
+            });
+        auto lowest = [&](const Int e)
+        {
+            Int e1 = mesh.lnext(e), e2 = mesh.lnext(e1);
+            if(mesh.lnext(e2) == e){
+                Int l = std::min({e, e1, e2});
+                if(counterclockwise[l]){
+                    return l;
+                }
+            }
+            return none;
+        };
+        parallel_chunks(threads, m, [&](const unsigned chunk, const size_t begin, const size_t end)
+            {
+                for(Int e = static_cast<Int>(2*begin); e < 2*end; e += 2){
+                    if(mesh.deleted(e)){
+                        continue;
+                    }
+                    Int l = lowest(e);
+                    if(l == e){
+                        triangle_count[chunk + 1]++;
+                    }else if(l == none){
+                        hull_count[chunk + 1]++;
+                    }
+                }
+            });
+        std::partial_sum(std::begin(triangle_count), std::end(triangle_count), std::begin(triangle_count));
+        std::partial_sum(std::begin(hull_count), std::end(hull_count), std::begin(hull_count));
+        const Int n = triangle_count.back();
+        if(n == 0){
+            return;
+        }
+        parallel_chunks(threads, m, [&](const unsigned chunk, const size_t begin, const size_t end)
+            {
+                Int t = triangle_count[chunk], h = n + hull_count[chunk];
+                for(Int e = static_cast<Int>(2*begin); e < 2*end; e += 2){
+                    if(mesh.deleted(e)){
+                        continue;
+                    }
+                    Int l = lowest(e);
+                    if(l == e){
+                        face[e] = t++;
+                    }else if(l == none){
+                        face[e] = h++;
+                    }
+                }
+            });
+        triangles_m.resize(n + hull_count.back());
+        instrumentation_m.count(Counter::triangle_allocations, n + hull_count.back());
+        // Edges of the outer face carry the number of their ghost triangle
+        auto face_of = [&](const Int f)
+        {
+            Int lf = lowest(f);
+            return lf == none ? face[f] : face[lf];
+        };
+        parallel_chunks(threads, m, [&](const unsigned, const size_t begin, const size_t end)
+            {
+                for(Int e = static_cast<Int>(2*begin); e < 2*end; e += 2){
+                    if(mesh.deleted(e)){
+                        continue;
+                    }
+                    Int l = lowest(e);
+                    if(l == e){
+                        Int e1 = mesh.lnext(e), e2 = mesh.lnext(e1);
+                        triangles_m[face[e]] = Triangle<Int>({mesh.org(e), mesh.org(e1), mesh.org(e2)},
+                            {face_of(mesh.sym(e1)), face_of(mesh.sym(e2)), face_of(mesh.sym(e))});
+                    }else if(l == none){
+                        // The outer face is traversed clockwise, so the left side
+                        // of a hull edge is outside
+                        triangles_m[face[e]] = Triangle<Int>({mesh.org(e), mesh.dest(e), infinite_vertex},
+                            {face[mesh.lnext(e)], face[mesh.lprev(e)], face_of(mesh.sym(e))});
+                    }
+                }
+            });
+        finite_m = n;
     }
 
-    std::tuple<Triangle<Int>, Triangle<Int>, Triangle<Int>> insert(const Int p, const Triangle<Int> t)
+    void triangulate_divide_and_conquer()
     {
-        auto [a, b, c] = t.vertices();
-        return {{p, b, c}, {a, p, c}, {a, b, p}};
+        auto phase = instrumentation_m.phase(Phase::divide_and_conquer);
+        auto less = [this](const Int a, const Int b)
+        {
+            auto va = vertices_m[a], vb = vertices_m[b];
+            return va.x() < vb.x() || (va.x() == vb.x() && va.y() < vb.y());
+        };
+        auto equal = [this](const Int a, const Int b)
+        {
+            return vertices_m[a] == vertices_m[b];
+        };
+        const size_t n = vertices_m.size();
+        if(threads_m <= 1 || n < 4096*size_t(threads_m)){
+            std::vector<Site> s(n);
+            for(size_t i = 0; i < n; i++){
+                s[i] = {vertices_m.coordinate(0, i), vertices_m.coordinate(1, i), static_cast<Int>(i)};
+            }
+            std::ranges::sort(s, [](const Site& a, const Site& b) {return precedes(0, a.x, a.y, b.x, b.y);});
+            auto [first, last] = std::ranges::unique(s, [](const Site& a, const Site& b) {return a.x == b.x && a.y == b.y;});
+            s.erase(first, last);
+            if(s.size() < 3){
+                return;
+            }
+            QuadEdges<Int> mesh;
+            mesh.reserve(3*s.size());
+            divide_and_conquer(mesh, s, 0, s.size(), 0);
+            from_quad_edges(mesh, 1);
+            return;
+        }
+
+        // Cut the plane into one vertical strip per thread, at x-quantiles
+        // estimated from a sample, and deal the points into the strips
+        const unsigned p = threads_m;
+        auto x = [this](const size_t i) {return vertices_m[i].x();};
+        std::vector<Float> sample;
+        const size_t stride = std::max(n/(64*size_t(p)), size_t(1));
+        for(size_t i = 0; i < n; i += stride){
+            sample.push_back(x(i));
+        }
+        std::ranges::sort(sample);
+        std::vector<Float> cuts(p - 1);
+        for(unsigned k = 1; k < p; k++){
+            cuts[k - 1] = sample[k*sample.size()/p];
+        }
+        auto strip = [&](const size_t i)
+        {
+            return static_cast<size_t>(std::ranges::upper_bound(cuts, x(i)) - std::begin(cuts));
+        };
+        std::vector<size_t> counts(size_t(p)*p + 1, 0);
+        parallel_chunks(p, n, [&](const unsigned chunk, const size_t begin, const size_t end)
+            {
+                for(size_t i = begin; i < end; i++){
+                    counts[strip(i)*p + chunk + 1]++;
+                }
+            });
+        std::partial_sum(std::begin(counts), std::end(counts), std::begin(counts));
+        std::vector<Int> s(n);
+        parallel_chunks(p, n, [&](const unsigned chunk, const size_t begin, const size_t end)
+            {
+                std::vector<size_t> next(p);
+                for(unsigned k = 0; k < p; k++){
+                    next[k] = counts[k*p + chunk];
+                }
+                for(size_t i = begin; i < end; i++){
+                    s[next[strip(i)]++] = static_cast<Int>(i);
+                }
+            });
+
+        // Sort every strip on its own thread. Equal x-values share a strip, so
+        // the strips are also sorted relative to each other.
+        std::vector<size_t> sizes(p + 1, 0);
+        auto at = [](std::vector<Int>& v, const size_t i) {return std::begin(v) + static_cast<std::ptrdiff_t>(i);};
+        parallel_chunks(p, p, [&](const unsigned k, const size_t, const size_t)
+            {
+                auto first = at(s, counts[k*p]), last = at(s, counts[(k + 1)*p]);
+                std::sort(first, last, less);
+                sizes[k + 1] = static_cast<size_t>(std::unique(first, last, equal) - first);
+            });
+        std::partial_sum(std::begin(sizes), std::end(sizes), std::begin(sizes));
+        std::vector<Int> sorted(sizes.back());
+        parallel_chunks(p, p, [&](const unsigned k, const size_t, const size_t)
+            {
+                std::copy_n(at(s, counts[k*p]), sizes[k + 1] - sizes[k], at(sorted, sizes[k]));
+            });
+        if(sorted.size() < 3){
+            return;
+        }
+        std::vector<Site> sites(sorted.size());
+        parallel_chunks(p, sorted.size(), [&](const unsigned, const size_t begin, const size_t end)
+            {
+                for(size_t i = begin; i < end; i++){
+                    sites[i] = {x(sorted[i]), vertices_m[sorted[i]].y(), sorted[i]};
+                }
+            });
+
+        // Strips with fewer than two points are joined to a neighbor, then
+        // every part is triangulated on its own thread
+        std::vector<size_t> bounds{0};
+        for(unsigned k = 0; k < p; k++){
+            if(sizes[k + 1] - bounds.back() >= 2 && sites.size() - sizes[k + 1] >= 2){
+                bounds.push_back(sizes[k + 1]);
+            }
+        }
+        if(bounds.back() != sites.size()){
+            bounds.push_back(sites.size());
+        }
+        const auto parts = static_cast<unsigned>(bounds.size() - 1);
+        std::vector<QuadEdges<Int>> meshes(parts);
+        std::vector<std::tuple<Int, Int>> hulls(parts);
+        parallel_chunks(parts, parts, [&](const unsigned k, const size_t, const size_t)
+            {
+                meshes[k].reserve(3*(bounds[k + 1] - bounds[k]));
+                hulls[k] = divide_and_conquer(meshes[k], sites, bounds[k], bounds[k + 1], 0);
+            });
+
+        // Gather the strips in one mesh and merge them from left to right.
+        // The merges only touch the edges along the seams.
+        std::vector<Int> offsets(parts + 1, 0);
+        for(size_t k = 0; k < parts; k++){
+            offsets[k + 1] = offsets[k] + static_cast<Int>(meshes[k].size()/4);
+        }
+        QuadEdges<Int> mesh;
+        mesh.reserve(offsets.back() + 3*n/p);
+        mesh.resize(offsets.back());
+        parallel_chunks(parts, parts, [&](const unsigned k, const size_t, const size_t)
+            {
+                mesh.assign(meshes[k], offsets[k]);
+                meshes[k] = QuadEdges<Int>();
+            });
+        auto [ldo, ldi] = hulls.front();
+        for(size_t k = 1; k < parts; k++){
+            auto [rdi, rdo] = hulls[k];
+            std::tie(ldo, ldi) = merge(mesh, ldo, ldi, rdi + 4*offsets[k], rdo + 4*offsets[k]);
+        }
+        from_quad_edges(mesh, p);
     }
 
-    std::tuple<Triangle<Int>, Triangle<Int>, Triangle<Int>, Triangle<Int>> insert(const Int p, const Triangle<Int>& t1, const Triangle<Int>& t2)
+    // Radial sweep (S-hull, as in delaunator). Starting from the seed triangle
+    // with the smallest circumcircle near the center, the points are added in
+    // order of distance from its circumcenter, each one outside the current
+    // convex hull. The hull is a linked list of vertices, and a hash on the
+    // pseudo-angle around the circumcenter finds a hull edge visible from the
+    // new point. New edges are legalized by flipping. Triangles are kept as
+    // flat arrays during the sweep: tris holds three vertices per triangle,
+    // and half-edge h, from tris[h] to the next vertex of its triangle, has
+    // the opposite half-edge halfedges[h].
+    void triangulate_sweep_hull()
     {
+        auto phase = instrumentation_m.phase(Phase::sweep_hull);
+        constexpr Int none = std::numeric_limits<Int>::max();
+        const Int n = static_cast<Int>(vertices_m.size());
+        if(n < 3){
+            return;
+        }
+        auto x = [this](const Int i) {return vertices_m[i].x();};
+        auto y = [this](const Int i) {return vertices_m[i].y();};
+        auto circumcenter = [&](const Int a, const Int b, const Int c)
+        {
+            Float dx = x(b) - x(a), dy = y(b) - y(a);
+            Float ex = x(c) - x(a), ey = y(c) - y(a);
+            Float bl = dx*dx + dy*dy, cl = ex*ex + ey*ey;
+            Float d = Float(0.5)/(dx*ey - dy*ex);
+            return std::tuple<Float, Float>{(ey*bl - dy*cl)*d, (dx*cl - ex*bl)*d};
+        };
+
+        // Seed triangle
+        auto [xmin, xmax] = std::ranges::minmax(vertices_m.coordinates(0));
+        auto [ymin, ymax] = std::ranges::minmax(vertices_m.coordinates(1));
+        auto closest = [&](const Float cx, const Float cy, const Int skip)
+        {
+            Int res = none;
+            Float d_min = std::numeric_limits<Float>::max();
+            for(Int i = 0; i < n; i++){
+                Float d = (x(i) - cx)*(x(i) - cx) + (y(i) - cy)*(y(i) - cy);
+                if(i != skip && d < d_min && !(skip != none && d == 0)){
+                    d_min = d;
+                    res = i;
+                }
+            }
+            return res;
+        };
+        Int i0 = closest((xmin + xmax)/2, (ymin + ymax)/2, none);
+        Int i1 = closest(x(i0), y(i0), i0);
+        if(i1 == none){
+            return;
+        }
+        Int i2 = none;
+        Float r_min = std::numeric_limits<Float>::max();
+        for(Int i = 0; i < n; i++){
+            if(i == i0 || i == i1 || orientation(vertices_m[i0], vertices_m[i1], vertices_m[i]) == 0){
+                continue;
+            }
+            auto [rx, ry] = circumcenter(i0, i1, i);
+            Float r = rx*rx + ry*ry;
+            if(r < r_min){
+                r_min = r;
+                i2 = i;
+            }
+        }
+        if(i2 == none){
+            return;
+        }
+        if(orientation(vertices_m[i0], vertices_m[i1], vertices_m[i2]) < 0){
+            std::swap(i1, i2);
+        }
+        auto [cx, cy] = circumcenter(i0, i1, i2);
+        cx += x(i0);
+        cy += y(i0);
+
+        std::vector<Float> dists(n);
+        for(Int i = 0; i < n; i++){
+            dists[i] = (x(i) - cx)*(x(i) - cx) + (y(i) - cy)*(y(i) - cy);
+        }
+        std::vector<Int> ids(n);
+        std::iota(std::begin(ids), std::end(ids), Int(0));
+        std::ranges::sort(ids, [&](const Int a, const Int b) {return dists[a] < dists[b];});
+
+        // Hull, counterclockwise, and the half-edge of the hull edge out of each hull vertex
+        const Int hash_size = static_cast<Int>(std::ceil(std::sqrt(static_cast<double>(n))));
+        std::vector<Int> hull_next(n), hull_prev(n), hull_tri(n), hull_hash(hash_size, none);
+        auto hash_key = [&](const Int i)
+        {
+            Float dx = x(i) - cx, dy = y(i) - cy;
+            Float p = dx/(std::abs(dx) + std::abs(dy));
+            Float angle = (dy > 0 ? 3 - p : 1 + p)/4;
+            return static_cast<Int>(std::floor(angle*static_cast<Float>(hash_size))) % hash_size;
+        };
+
+        std::vector<Int> tris, halfedges;
+        tris.reserve(6*n);
+        halfedges.reserve(6*n);
+        auto link = [&](const Int a, const Int b)
+        {
+            halfedges[a] = b;
+            if(b != none){
+                halfedges[b] = a;
+            }
+        };
+        auto add_triangle = [&](const Int a, const Int b, const Int c, const Int ha, const Int hb, const Int hc)
+        {
+            Int t = static_cast<Int>(tris.size());
+            tris.insert(std::end(tris), {a, b, c});
+            halfedges.insert(std::end(halfedges), {none, none, none});
+            link(t, ha);
+            link(t + 1, hb);
+            link(t + 2, hc);
+            return t;
+        };
+        Int hull_start = i0;
+
+        // Flip half-edge a, and recursively the edges behind it, until they
+        // are locally Delaunay. Returns the half-edge out of the new point
+        // that ends up on the hull.
+        auto legalize = [&](Int a)
+        {
+            Int ar = 0;
+            flip_stack_m.clear();
+            while(true){
+                Int b = halfedges[a];
+                Int a0 = a - a % 3;
+                ar = a0 + (a + 2) % 3;
+                if(b == none){
+                    if(flip_stack_m.empty()){
+                        break;
+                    }
+                    a = flip_stack_m.back();
+                    flip_stack_m.pop_back();
+                    continue;
+                }
+                Int b0 = b - b % 3;
+                Int al = a0 + (a + 1) % 3;
+                Int bl = b0 + (b + 2) % 3;
+                Int p0 = tris[ar], pr = tris[a], pl = tris[al], p1 = tris[bl];
+                if(in_circle(vertices_m[p0], vertices_m[pr], vertices_m[pl], vertices_m[p1]) > 0){
+                    tris[a] = p1;
+                    tris[b] = p0;
+                    Int hbl = halfedges[bl];
+                    // The flipped edge was on the hull, fix its reference.
+                    // A hull edge starts from p1, whose reference it is, so
+                    // there is no need to walk the hull, which with every
+                    // point on it would take quadratic time.
+                    if(hbl == none && hull_tri[p1] == bl){
+                        hull_tri[p1] = a;
+                    }
+                    link(a, hbl);
+                    link(b, halfedges[ar]);
+                    link(ar, bl);
+                    flip_stack_m.push_back(b0 + (b + 1) % 3);
+                }else{
+                    if(flip_stack_m.empty()){
+                        break;
+                    }
+                    a = flip_stack_m.back();
+                    flip_stack_m.pop_back();
+                }
+            }
+            return ar;
+        };
+
+        hull_next[i0] = hull_prev[i2] = i1;
+        hull_next[i1] = hull_prev[i0] = i2;
+        hull_next[i2] = hull_prev[i1] = i0;
+        hull_tri[i0] = 0;
+        hull_tri[i1] = 1;
+        hull_tri[i2] = 2;
+        hull_hash[hash_key(i0)] = i0;
+        hull_hash[hash_key(i1)] = i1;
+        hull_hash[hash_key(i2)] = i2;
+        add_triangle(i0, i1, i2, none, none, none);
+
+        auto visible = [&](const Int i, const Int a, const Int b)
+        {
+            return orientation(vertices_m[a], vertices_m[b], vertices_m[i]) < 0;
+        };
+        for(Int k = 0; k < n; k++){
+            Int i = ids[k];
+            if(i == i0 || i == i1 || i == i2 || (k > 0 && vertices_m[i] == vertices_m[ids[k - 1]])){
+                continue;
+            }
+            // A hull edge visible from the point, found starting from the hash
+            Int start = 0;
+            Int key = hash_key(i);
+            for(Int j = 0; j < hash_size; j++){
+                start = hull_hash[(key + j) % hash_size];
+                if(start != none && start != hull_next[start]){
+                    break;
+                }
+            }
+            start = hull_prev[start];
+            Int e = start, q;
+            while(q = hull_next[e], !visible(i, e, q)){
+                e = q;
+                if(e == start){
+                    e = none;
+                    break;
+                }
+            }
+            // Duplicate of a hull vertex
+            if(e == none){
+                continue;
+            }
+
+            Int t = add_triangle(e, i, hull_next[e], none, none, hull_tri[e]);
+            hull_tri[i] = legalize(t + 2);
+            hull_tri[e] = t;
+
+            // Walk forward and backward along the hull, adding a triangle for
+            // every other edge the point can see
+            Int nx = hull_next[e];
+            while(q = hull_next[nx], visible(i, nx, q)){
+                t = add_triangle(nx, i, q, hull_tri[i], none, hull_tri[nx]);
+                hull_tri[i] = legalize(t + 2);
+                hull_next[nx] = nx;
+                nx = q;
+            }
+            if(e == start){
+                while(q = hull_prev[e], visible(i, q, e)){
+                    t = add_triangle(q, i, e, none, hull_tri[e], hull_tri[q]);
+                    legalize(t + 2);
+                    hull_tri[q] = t;
+                    hull_next[e] = e;
+                    e = q;
+                }
+            }
+            hull_start = hull_prev[i] = e;
+            hull_next[e] = hull_prev[nx] = i;
+            hull_next[i] = nx;
+            hull_hash[hash_key(i)] = i;
+            hull_hash[hash_key(e)] = e;
+        }
+
+        // Finite triangles first, then a ghost triangle for each hull edge,
+        // numbered by the vertex the hull edge starts from. hull_prev is no
+        // longer needed and holds the numbering.
+        const Int finite = static_cast<Int>(tris.size()/3);
+        triangles_m.reserve(finite + n);
+        std::vector<Int>& ghost = hull_prev;
+        Int hull_size = 0;
+        Int h = hull_start;
+        do{
+            ghost[h] = finite + hull_size++;
+            h = hull_next[h];
+        }while(h != hull_start);
+        for(Int t = 0; t < finite; t++){
+            Triangle<Int> tri{tris[3*t], tris[3*t + 1], tris[3*t + 2]};
+            for(Int k = 0; k < 3; k++){
+                Int he = 3*t + (k + 1) % 3;
+                tri.neighbors()[k] = halfedges[he] != none ? halfedges[he]/3 : ghost[tris[he]];
+            }
+            triangles_m.allocate(tri);
+        }
+        Int prev = hull_start;
+        while(hull_next[prev] != hull_start){
+            prev = hull_next[prev];
+        }
+        h = hull_start;
+        do{
+            Int w = hull_next[h];
+            triangles_m.allocate(Triangle<Int>({w, h, infinite_vertex}, {ghost[prev], ghost[w], hull_tri[h]/3}));
+            prev = h;
+            h = w;
+        }while(h != hull_start);
+        instrumentation_m.count(Counter::triangle_allocations, finite + hull_size);
+        finite_m = finite;
+    }
 
-        auto ta = t1;
-        auto tb = t2;
+    // Triangulate the vertices already in vertices_m
+    void triangulate_vertices(const Engine engine)
+    {
+        auto phase = instrumentation_m.phase(Phase::triangulate);
+        triangles_m.clear();
+        finite_m = 0;
+        vertex_triangles_m.clear();
+        invalidate_derived();
+        if(engine == Engine::divide_and_conquer){
+            triangulate_divide_and_conquer();
+            return;
+        }
+        if(engine == Engine::sweep_hull){
+            triangulate_sweep_hull();
+            return;
+        }
+        // Points are inserted, and stored while triangulating, in spatial
+        // order. The vertex indices are mapped back to the caller's order at
+        // the end.
+        std::vector<Int> order;
+        VertexStore<Float> given;
+        if(insertion_order_m == InsertionOrder::brio){
+            auto sort = instrumentation_m.phase(Phase::insertion_order);
+            order = brio_order<Int>(vertices_m);
+            given = std::move(vertices_m);
+            vertices_m = VertexStore<Float>();
+            vertices_m.resize(given.size());
+            for(size_t i = 0; i < order.size(); i++){
+                vertices_m[i] = given[order[i]];
+            }
+        }
+        auto t0 = initial_triangle(vertices_m);
+        if(!t0){
+            if(!order.empty()){
+                vertices_m = std::move(given);
+            }
+            return;
+        }
+        auto [a, b, c] = t0->vertices();
+        triangles_m.reserve(2*vertices_m.size());
+        triangles_m.allocate(Triangle<Int>({a, b, c}, {1, 2, 3}));
+        triangles_m.allocate(Triangle<Int>({c, b, infinite_vertex}, {3, 2, 0}));
+        triangles_m.allocate(Triangle<Int>({a, c, infinite_vertex}, {1, 3, 0}));
+        triangles_m.allocate(Triangle<Int>({b, a, infinite_vertex}, {2, 1, 0}));
+        instrumentation_m.count(Counter::triangle_allocations, 4);
 
-        // Rotate both triangles so that their unique vertices are placed first
-        for(auto it = std::begin(ta); it != std::end(ta); it++){
-            if(std::find(std::begin(tb), std::end(tb), *it) == std::end(tb)){
-                ta.cycle(std::distance(std::begin(ta), it));
+        {
+            auto loop = instrumentation_m.phase(Phase::incremental);
+            Int last = 0;
+            for(Int i = 0; i < vertices_m.size(); i++){
+                if(i != a && i != b && i != c){
+                    last = insert_vertex(i, last);
+                }
             }
         }
-        for(auto it = std::begin(tb); it != std::end(tb); it++){
-            if(std::find(std::begin(ta), std::end(ta), *it) == std::end(ta)){
-                tb.cycle(std::distance(std::begin(tb), it));
+        auto compact = instrumentation_m.phase(Phase::compact);
+        triangles_m.compact([this](const Triangle<Int>& t) {return !is_ghost(t);});
+        finite_m = static_cast<Int>(std::ranges::count_if(triangles_m, [this](const Triangle<Int>& t) {return !is_ghost(t);}));
+        if(!order.empty()){
+            for(auto& t : triangles_m){
+                for(Int& i : t){
+                    if(i != infinite_vertex){
+                        i = order[i];
+                    }
+                }
             }
+            vertices_m = std::move(given);
+        }
+    }
+
+public:
+    void triangulate(const std::vector<Vertex<Float>>& points, const Engine engine = Engine::incremental)
+    {
+        vertices_m.assign(points);
+        triangulate_vertices(engine);
+    }
+
+    // Points given as interleaved coordinates, point i at coordinates[i*stride]
+    // and coordinates[i*stride + 1]. Throws std::invalid_argument if stride
+    // is less than 2, which would make the points overlap.
+    void triangulate(std::span<const Float> coordinates, const size_t stride = 2, const Engine engine = Engine::incremental)
+    {
+        if(stride < 2){
+            throw std::invalid_argument("Stride must be at least the 2 coordinates of a point");
         }
-        auto [a, b, c] = ta.vertices();
-        auto d = tb.front();
-        return {{a, b, p}, {b, d,  p}, {b, c, p}, {c, a, p}};
+        const size_t n = coordinates.size() < 2 ? 0 : (coordinates.size() - 2)/stride + 1;
+        vertices_m.resize(n);
+        for(size_t i = 0; i < n; i++){
+            vertices_m.coordinate(0, i) = coordinates[i*stride];
+            vertices_m.coordinate(1, i) = coordinates[i*stride + 1];
+        }
+        triangulate_vertices(engine);
     }
 
+    // Remove vertex v from the triangulation. Only the triangles around v
+    // change, and v keeps its index and coordinates so no other index does.
+    // Returns false if v was not part of the triangulation, e.g. a duplicate
+    // point or a vertex removed before. Throws std::domain_error if the
+    // remaining vertices are all collinear.
+    bool remove(const Int v)
+    {
+        if(v >= vertices_m.size()){
+            throw std::out_of_range("No vertex with this index");
+        }
+        auto t = vertex_triangle(v);
+        if(!t){
+            return false;
+        }
+        auto phase = instrumentation_m.phase(Phase::remove);
+        if(!remove_vertex(v, *t)){
+            throw std::domain_error("Removing the vertex would leave no triangle");
+        }
+        return true;
+    }
 
-    std::tuple<Triangle<Int>, Triangle<Int>> flip(const Triangle<Int>& t1, const Triangle<Int>& t2)
+    // Move vertex v to p. A vertex inside the convex hull that stays inside
+    // the polygon of its neighbors is moved in place and the edges around it
+    // legalized, otherwise it is removed and inserted again. A vertex that
+    // was not part of the triangulation is inserted.
+    void move(const Int v, const Vertex<Float>& p)
     {
-        auto ta = t1;
-        auto tb = t2;
+        if(v >= vertices_m.size()){
+            throw std::out_of_range("No vertex with this index");
+        }
+        auto phase = instrumentation_m.phase(Phase::move);
+        auto t = vertex_triangle(v);
+        Int hint = 0;
+        if(t){
+            collect_star(v, *t);
+            bool inside = std::ranges::find(link_m, infinite_vertex) == std::end(link_m);
+            for(size_t j = 0; j < link_m.size() && inside; j++){
+                inside = orientation(vertices_m[link_m[j]], vertices_m[link_m[(j + 1) % link_m.size()]], p) > 0;
+            }
+            if(inside){
+                vertices_m[v] = p;
+                mark_changed(star_m);
+                edge_stack_m.clear();
+                for(const Int s : star_m){
+                    for(const auto& n : triangles_m[s].neighbors()){
+                        edge_stack_m.emplace_back(s, *n);
+                    }
+                }
+                legalize_edges();
+                return;
+            }
+            if(!remove_vertex(v, *t)){
+                // The other vertices are collinear, so the triangulation is
+                // all about v and starts over
+                vertices_m[v] = p;
+                triangulate_vertices(Engine::incremental);
+                return;
+            }
+            hint = vertex_triangles_m[link_m[0] != infinite_vertex ? link_m[0] : link_m[1]];
+        }
+        vertices_m[v] = p;
+        if(finite_m == 0){
+            triangulate_vertices(Engine::incremental);
+            return;
+        }
+        finite_delta_m = 0;
+        Int s = insert_vertex(v, hint < triangles_m.size() ? hint : 0);
+        std::vector<Int> touched;
+        if(std::ranges::find(triangles_m[s], v) != std::end(triangles_m[s])){
+            collect_star(v, s);
+            touched = star_m;
+            for(const Int u : star_m){
+                update_vertex_triangles(u);
+            }
+        }
+        restore_order(touched, finite_m + finite_delta_m);
+    }
 
-        // Rotate both triangles so that their unique vertices are placed first
-        for(auto it = std::begin(ta); it != std::end(ta); it++){
-            if(std::find(std::begin(tb), std::end(tb), *it) == std::end(tb)){
-                ta.cycle(std::distance(std::begin(ta), it));
+    // Add points to the triangulation, sorted along a space-filling curve so
+    // each walk starts next to the last inserted point. Only the triangles
+    // around the new vertices change. Returns the vertex index of every
+    // point in the order given, which for a point already present is that of
+    // the vertex at its position.
+    std::vector<Int> insert(std::span<const Vertex<Float>> points)
+    {
+        auto phase = instrumentation_m.phase(Phase::insert);
+        const size_t base = vertices_m.size();
+        std::vector<Int> res(points.size());
+        std::iota(std::begin(res), std::end(res), static_cast<Int>(base));
+        vertices_m.resize(base + points.size());
+        for(size_t i = 0; i < points.size(); i++){
+            vertices_m[base + i] = points[i];
+        }
+        auto at_same_position = [&](const Triangle<Int>& t, const Int p)
+        {
+            return *std::ranges::find_if(t, [&](const Int w)
+                {
+                    return w != infinite_vertex && vertices_m[w].x() == vertices_m[p].x() && vertices_m[w].y() == vertices_m[p].y();
+                });
+        };
+        if(finite_m == 0){
+            // Every earlier vertex is collinear, so start over
+            triangulate_vertices(Engine::incremental);
+            for(size_t i = 0; i < points.size() && finite_m > 0; i++){
+                if(!vertex_triangle(res[i])){
+                    auto [t, location, k] = walk_to(vertices_m[res[i]], 0);
+                    res[i] = at_same_position(triangles_m[t], res[i]);
+                }
             }
+            return res;
         }
-        for(auto it = std::begin(tb); it != std::end(tb); it++){
-            if(std::find(std::begin(ta), std::end(ta), *it) == std::end(ta)){
-                tb.cycle(std::distance(std::begin(tb), it));
+        if(vertex_triangles_m.size() == base){
+            vertex_triangles_m.resize(vertices_m.size(), OptionalIndex<Int>::none);
+        }
+        finite_delta_m = 0;
+        Int hint = 0;
+        for(const Int i : brio_order<Int>(points)){
+            const Int p = res[i];
+            hint = insert_vertex(p, hint);
+            if(std::ranges::find(triangles_m[hint], p) == std::end(triangles_m[hint])){
+                res[i] = at_same_position(triangles_m[hint], p);
+            }else if(vertex_triangles_m.size() == vertices_m.size()){
+                vertex_triangles_m[p] = hint;
+            }
+        }
+        std::vector<Int> touched;
+        for(size_t i = 0; i < points.size(); i++){
+            if(res[i] != base + i){
+                continue;
+            }
+            if(auto t = vertex_triangle(res[i])){
+                collect_star(res[i], *t);
+                touched.insert(std::end(touched), std::begin(star_m), std::end(star_m));
             }
         }
+        restore_order(touched, finite_m + finite_delta_m);
+        return res;
+    }
 
-        auto [a, b, c] = ta.vertices();
-        auto d = tb.front();
-        auto [naa, nab, nac] = ta.neighbors();
-        auto [nbd, nbc, nbb] = tb.neighbors();
-        return {{{b, d, a}, {naa, nac, nbc}}, {{c, d, a}, {nab, nbd, nbb}}};
+    // Triangle containing p, as returned by walk(), found by walking from
+    // triangle hint, e.g. the one found for a point nearby. Changes nothing,
+    // so queries may run on several threads at once.
+    std::tuple<Int, Location, Int> locate(const Vertex<Float>& p, const Int hint = 0) const
+    {
+        return view().locate(p, hint);
     }
 
-    Triangle<Float> initial_triangle(const std::vector<Vertex<Float>>& points)
+    // Vertex closest to p, see locate() for the hint
+    Int nearest_vertex(const Vertex<Float>& p, const Int hint = 0) const
     {
-        Float xmin, xmax, ymin, ymax;
-        Vertex<Float> p0 = points.front();
-        auto xmax_it = std::max_element(std::begin(points), std::end(points),
-            [](const Vertex<Float>& a, const Vertex<Float>& b)
-            {
-                return *a.begin() < *b.begin();
-            });
-        xmax = *(*xmax_it).begin();
-        auto ymax_it = std::max_element(std::begin(points), std::end(points),
-            [](const Vertex<Float>& a, const Vertex<Float>& b)
+        return view().nearest_vertex(p, hint);
+    }
+
+    // The k vertices closest to p, closest first, see DelaunayView::k_nearest()
+    std::vector<Int> k_nearest(const Vertex<Float>& p, const size_t k, const Int hint = 0) const
+    {
+        return view().k_nearest(p, k, hint);
+    }
+
+    // Batch queries. The points are sorted along a Hilbert curve, so each
+    // walk starts from the triangle of the point before, and shared out
+    // between threads() threads.
+    std::vector<std::tuple<Int, Location, Int>> locate(std::span<const Vertex<Float>> points) const
+    {
+        std::vector<std::tuple<Int, Location, Int>> res(points.size());
+        for_each_query(points, [&](const unsigned, const size_t i, const Int hint)
             {
-                return *(a.begin() + 1) < *(b.begin() + 1);
+                res[i] = locate(points[i], hint);
+                return std::get<0>(res[i]);
             });
-        ymax = *((*ymax_it).begin() + 1);
-        auto xmin_it = std::min_element(std::begin(points), std::end(points),
-            [](const Vertex<Float>& a, const Vertex<Float>& b)
+        return res;
+    }
+
+    std::vector<Int> nearest_vertex(std::span<const Vertex<Float>> points) const
+    {
+        std::vector<Int> res(points.size());
+        for_each_query(points, [&](const unsigned, const size_t i, const Int hint)
             {
-                return *a.begin() < *b.begin();
+                auto [v, t] = descend(points[i], std::get<0>(locate(points[i], hint)));
+                res[i] = v;
+                return t;
             });
-        xmin = *(*xmin_it).begin();
-        auto ymin_it = std::min_element(std::begin(points), std::end(points),
-            [](const Vertex<Float>& a, const Vertex<Float>& b)
+        return res;
+    }
+
+    // k vertices per point, padded with infinite_vertex if there are fewer
+    std::vector<Int> k_nearest(std::span<const Vertex<Float>> points, const size_t k) const
+    {
+        std::vector<Int> res(k*points.size(), infinite_vertex);
+        const auto v = view();
+        std::vector<typename DelaunayView<Float, Int>::NearestScratch> scratch(std::max(threads_m, 1u));
+        for_each_query(points, [&](const unsigned chunk, const size_t i, const Int hint)
             {
-                return *(a.begin() + 1) < *(b.begin() + 1);
+                auto [t, location, j] = v.locate(points[i], hint);
+                v.k_nearest(points[i], std::span(res).subspan(k*i, k), t, scratch[chunk]);
+                return t;
             });
-        ymin = *((*ymin_it).begin() + 1);
+        return res;
+    }
 
-        std::cout << "xmin = " << xmin << ", xmax = " << xmax << "\n";
-        std::cout << "ymin = " << ymin << ", ymax = " << ymax << "\n";
+    // Voronoi diagram of the vertices, with the cells clipped to the box
+    // from lo to hi. It is kept, so asking again without edits costs
+    // nothing. After edits only the circumcenters of the triangles they
+    // changed are recomputed, and only the cells of their vertices gathered
+    // and clipped again; still every call after an edit passes over all
+    // triangles and copies the other cells, which is O(n). Edits changing
+    // more than a quarter of the triangles, or a different box, rebuild
+    // everything.
+    const VoronoiDiagram<Float, Int>& voronoi(const Vertex<Float>& lo, const Vertex<Float>& hi) requires Floating<Float>
+    {
+        const std::array<Float, 4> box{lo.x(), lo.y(), hi.x(), hi.y()};
+        if(cells_valid_m && changed_m.empty() && box == voronoi_box_m){
+            return voronoi_m;
+        }
+        auto phase = instrumentation_m.phase(Phase::voronoi);
+        const bool update = circumcenters_valid_m && changed_m.size() <= size_t(finite_m)/4;
+        VoronoiDiagram<Float, Int> old;
+        std::vector<bool> stale;
+        if(update && cells_valid_m && box == voronoi_box_m){
+            stale.assign(vertices_m.size(), false);
+            for(const Int t : changed_m){
+                if(t < triangles_m.size()){
+                    for(const Int v : triangles_m[t]){
+                        if(v != infinite_vertex){
+                            stale[v] = true;
+                        }
+                    }
+                }
+            }
+            old.offsets_m = std::move(voronoi_m.offsets_m);
+            old.indices_m = std::move(voronoi_m.indices_m);
+            old.x_m.assign(std::begin(voronoi_m.x_m) + static_cast<std::ptrdiff_t>(voronoi_finite_m), std::end(voronoi_m.x_m));
+            old.y_m.assign(std::begin(voronoi_m.y_m) + static_cast<std::ptrdiff_t>(voronoi_finite_m), std::end(voronoi_m.y_m));
+        }
+        voronoi_m.x_m.resize(finite_m);
+        voronoi_m.y_m.resize(finite_m);
+        if(!update){
+            std::vector<Int> all(finite_m);
+            std::iota(std::begin(all), std::end(all), Int(0));
+            compute_circumcenters(all);
+        }else{
+            std::ranges::sort(changed_m);
+            changed_m.erase(std::unique(std::begin(changed_m), std::end(changed_m)), std::end(changed_m));
+            std::erase_if(changed_m, [this](const Int t) {return t >= finite_m;});
+            compute_circumcenters(changed_m);
+        }
+        changed_m.clear();
+        circumcenters_valid_m = true;
+        build_cells(box, old, voronoi_finite_m, stale);
+        cells_valid_m = true;
+        voronoi_box_m = box;
+        voronoi_finite_m = finite_m;
+        return voronoi_m;
+    }
 
-        Float dx = (xmax - xmin)/2, dy = (ymax - ymin);
+    // Clipped to the bounding box of the vertices grown by half its size on
+    // every side
+    const VoronoiDiagram<Float, Int>& voronoi() requires Floating<Float>
+    {
+        if(vertices_m.size() == 0){
+            return voronoi({0, 0}, {0, 0});
+        }
+        auto [xmin, xmax] = std::ranges::minmax(vertices_m.coordinates(0));
+        auto [ymin, ymax] = std::ranges::minmax(vertices_m.coordinates(1));
+        Float margin = std::max<Float>(std::max(xmax - xmin, ymax - ymin)/2, 1);
+        return voronoi({xmin - margin, ymin - margin}, {xmax + margin, ymax + margin});
+    }
 
-        return {{xmin - dx, ymin}, {xmax + dx, ymin}, {xmin + dx, ymax + dy}};
+    // Interpolate a field given by components values per vertex, stored
+    // vertex by vertex, at every point, writing components values per point
+    // to out. Linear interpolation weighs the corners of the triangle around
+    // a point by their barycentric coordinates, natural neighbor
+    // interpolation weighs the vertices whose Voronoi cells a point would
+    // take area from by that area (Sibson). Points outside the convex hull
+    // get outside. The points are handled as by the batch queries.
+    template<Floating Value = double>
+    void interpolate(std::span<const std::type_identity_t<Value>> values, const size_t components,
+                     std::span<const Vertex<Float>> points, std::span<std::type_identity_t<Value>> out,
+                     const Interpolation method = Interpolation::linear,
+                     const std::type_identity_t<Value> outside = std::numeric_limits<Value>::quiet_NaN()) const
+    {
+        check_interpolation(values.size(), components, out.size(), points.size());
+        if(finite_m == 0){
+            std::ranges::fill(out.first(components*points.size()), outside);
+            return;
+        }
+        for_each_query(points, [&](const unsigned, const size_t i, const Int hint)
+            {
+                return interpolate_at(values, components, points[i], out.subspan(components*i, components), method, outside, hint);
+            });
     }
 
-    void triangulate(const std::vector<Vertex<Float>>& points)
+    // On a grid, with the rows shared out between threads. Each walk starts
+    // from the point before in the row, or from the first one in the row
+    // before.
+    template<Floating Value = double>
+    void interpolate(std::span<const std::type_identity_t<Value>> values, const size_t components,
+                     const Grid<Float>& grid, std::span<std::type_identity_t<Value>> out,
+                     const Interpolation method = Interpolation::linear,
+                     const std::type_identity_t<Value> outside = std::numeric_limits<Value>::quiet_NaN()) const
     {
-        Triangle<Float> t0 = initial_triangle(points);
-        std::cout << "t0 = " << t0 << "\n";
-        vertices_m.insert(std::begin(vertices_m), std::begin(t0), std::end(t0));
-        triangles_m.push_back({0, 1, 2});
+        check_interpolation(values.size(), components, out.size(), grid.size());
+        if(finite_m == 0){
+            std::ranges::fill(out.first(components*grid.size()), outside);
+            return;
+        }
+        parallel_chunks(threads_m, grid.ny, [&](const unsigned, const size_t begin, const size_t end)
+            {
+                Int hint = 0;
+                for(size_t j = begin; j < end; j++){
+                    Int row = hint;
+                    for(size_t i = 0; i < grid.nx; i++){
+                        const size_t k = j*grid.nx + i;
+                        hint = interpolate_at(values, components, grid(i, j), out.subspan(components*k, components), method, outside, hint);
+                        if(i == 0){
+                            row = hint;
+                        }
+                    }
+                    hint = row;
+                }
+            });
+    }
+
+    // Inserts points from several threads at once. An insertion walks to its
+    // point and then claims the triangles whose circumcircle contains it,
+    // together with their neighbors, by setting owner flags on their slots.
+    // If any of them is owned by another insertion the claims are dropped and
+    // the insertion is retried, otherwise the claimed cavity is replaced by
+    // the star of the new vertex. Room for the points is reserved up front,
+    // and the triangulation must not be used in any other way while the
+    // inserter is alive.
+    class ConcurrentInserter{
+    private:
+        Delaunay& delaunay_m;
+        size_t vertex_end_m;
+        size_t triangle_end_m;
+        std::atomic<size_t> vertex_count_m;
+        std::atomic<size_t> triangle_count_m;
+        std::atomic<uint32_t> tokens_m = 0;
+        std::atomic<size_t> retries_m = 0;
+        std::unique_ptr<std::atomic<uint32_t>[]> owners_m;
+
+        bool try_claim(const Int t, const uint32_t token, std::vector<Int>& claimed)
+        {
+            uint32_t owner = 0;
+            if(owners_m[t].compare_exchange_strong(owner, token, std::memory_order_acquire)){
+                claimed.push_back(t);
+                return true;
+            }
+            return owner == token;
+        }
+
+        void release(std::vector<Int>& claimed)
+        {
+            for(Int t : claimed){
+                owners_m[t].store(0, std::memory_order_release);
+            }
+            claimed.clear();
+        }
 
-        for(auto p : points){
-            std::vector<Triangle<Int>> containers;
-            auto t_it = std::begin(triangles_m);
-            while(t_it != std::end(triangles_m)){
-                t_it = std::find_if(t_it, std::end(triangles_m),
-                    [this, p] (const Triangle<Int>& t_i)
-                    {
-                        return triangle_contains(t_i, p);
-                    });
-                if(t_it != std::end(triangles_m)){
-                    containers.push_back(*(t_it++));
+        // Walk towards p, only reading a triangle while owning it. Returns the
+        // triangle containing p, still claimed. The triangle the walk came
+        // from may have been replaced since, so unlike locate every edge is
+        // tested.
+        Int walk(const Vertex<Float>& p, Int t, const uint32_t token, std::vector<Int>& claimed, std::minstd_rand& rng)
+        {
+            const auto& vertices = delaunay_m.vertices_m;
+            while(true){
+                while(!try_claim(t, token, claimed)){
+                    std::this_thread::yield();
+                }
+                const Triangle<Int> tri = delaunay_m.triangles_m[t];
+                const auto& vs = tri.vertices();
+                const auto& ns = tri.neighbors();
+                std::optional<Int> next;
+                if(delaunay_m.is_ghost(tri)){
+                    Int k = static_cast<Int>(std::ranges::find(vs, infinite_vertex) - std::begin(vs));
+                    if(delaunay_m.orientation(vertices[vs[(k + 1) % 3]], vertices[vs[(k + 2) % 3]], p) <= 0){
+                        next = ns[k];
+                    }
+                }else{
+                    Int offset = static_cast<Int>(rng() % 3);
+                    for(Int k = 0; k < 3 && !next; k++){
+                        Int e = (offset + k) % 3;
+                        if(delaunay_m.orientation(vertices[vs[(e + 1) % 3]], vertices[vs[(e + 2) % 3]], p) < 0){
+                            next = ns[e];
+                        }
+                    }
+                }
+                if(!next){
+                    return t;
                 }
+                release(claimed);
+                t = *next;
             }
-            if(containers.size() == 0){
-                std::cout << "Point, " << p << ", not inside any triangle!\n";
-                return;
-            }else{
-                for(auto t : containers){
-                    std::cout << "Point, " << p << ", inside triangle, " << t << "\n";
-                }
-            }
-
-            vertices_m.push_back(p);
-            if(containers.size() == 1){
-                auto t = containers.front();
-                auto t_it = std::find(std::begin(triangles_m), std::end(triangles_m), t);
-                auto [t1, t2, t3] = insert(vertices_m.size() - 1, *t_it);
-                auto [n1, n2, n3] = t_it->neighbors();
-                triangles_m.erase(t_it);
-                Int n = triangles_m.size() - 1;
-                t1.neighbors() = {n1, n - 1, n};
-                t2.neighbors() = {n - 2, n2, n};
-                t3.neighbors() = {n - 2, n - 1, n3};
-                /***************************************************************
-                *
-                ***************************************************************/
-                triangles_m.push_back(t1);
-                triangles_m.push_back(t2);
-                triangles_m.push_back(t3);
-            }else if(containers.size() == 2){
-                auto ta = containers.front(), tb = containers.back();
-                auto [t1, t2, t3, t4] = insert(vertices_m.size() - 1, ta, tb);
-                auto ta_it = std::find(std::begin(triangles_m), std::end(triangles_m), ta);
-                auto tb_it = std::find(std::begin(triangles_m), std::end(triangles_m), tb);
-                auto [tan1, tan2, tan3] = ta_it->neighbors();
-                auto [tbn1, tbn2, tbn3] = tb_it->neighbors();
-                triangles_m.erase(ta_it);
-                triangles_m.erase(tb_it);
-                Int n = triangles_m.size() - 1;
-                t1.neighbors() = {n - 2, n, tan3};
-                t2.neighbors() = {n - 1, n - 3, tbn2};
-                t3.neighbors() = {n, n - 2, tbn3};
-                t4.neighbors() = {n - 3, n - 1, tan2};
-                triangles_m.push_back(t1);
-                triangles_m.push_back(t2);
-                triangles_m.push_back(t3);
-                triangles_m.push_back(t4);
-            }
-        }
-        // Remove all triangles containing the vertices of t0
-        for(auto it = std::begin(triangles_m); it != std::end(triangles_m);){
-            auto [ai, bi, ci] = it->vertices();
-            if( ai == 0 || ai == 1 || ai == 2 ||
-                bi == 0 || bi == 1 || bi == 2 ||
-                ci == 0 || ci == 1 || ci == 2){
-                triangles_m.erase(it);
-            }else{
-                for(Int& i : *it){
-                    i -= 3;
+        }
+
+    public:
+        ConcurrentInserter(Delaunay& delaunay, const size_t points)
+         : delaunay_m(delaunay)
+        {
+            if(delaunay_m.finite_m == 0){
+                throw std::logic_error("Concurrent insertion needs a triangulation with at least one triangle");
+            }
+            vertex_count_m = vertex_end_m = delaunay_m.vertices_m.size();
+            triangle_count_m = delaunay_m.triangles_m.size();
+            delaunay_m.vertices_m.resize(vertex_end_m + points);
+            vertex_end_m += points;
+            // Every vertex adds exactly two triangles
+            delaunay_m.triangles_m.grow(2*points);
+            delaunay_m.instrumentation_m.count(Counter::triangle_allocations, 2*points);
+            triangle_end_m = delaunay_m.triangles_m.size();
+            owners_m = std::make_unique<std::atomic<uint32_t>[]>(triangle_end_m);
+        }
+
+        ConcurrentInserter(const ConcurrentInserter&) = delete;
+        ConcurrentInserter& operator=(const ConcurrentInserter&) = delete;
+
+        // Drop the unused room and restore the finite-first triangle order
+        ~ConcurrentInserter()
+        {
+            delaunay_m.vertices_m.resize(std::min<size_t>(vertex_count_m, vertex_end_m));
+            delaunay_m.instrumentation_m.count(Counter::triangle_releases, triangle_end_m - std::min<size_t>(triangle_count_m, triangle_end_m));
+            for(size_t t = triangle_count_m; t < triangle_end_m; t++){
+                delaunay_m.triangles_m.release(static_cast<Int>(t));
+            }
+            delaunay_m.triangles_m.compact([this](const Triangle<Int>& t) {return !delaunay_m.is_ghost(t);});
+            delaunay_m.finite_m = static_cast<Int>(std::ranges::count_if(delaunay_m.triangles_m,
+                [this](const Triangle<Int>& t) {return !delaunay_m.is_ghost(t);}));
+            delaunay_m.invalidate_derived();
+        }
+
+        // Safe to call from several threads at once. Returns the index of the
+        // new vertex, or of an existing vertex at the same position, and a
+        // triangle next to it to use as the hint for a nearby point.
+        std::tuple<Int, Int> insert(const Vertex<Float>& p, const Int hint = 0)
+        {
+            thread_local std::vector<Int> claimed, cavity;
+            // Cavity triangle, local index of the boundary edge and the
+            // neighbor across it together with its local index of the edge
+            thread_local std::vector<std::tuple<Int, Int, Int, Int>> boundary;
+            thread_local std::vector<Triangle<Int>> star;
+            thread_local std::minstd_rand rng;
+            uint32_t token = ++tokens_m;
+            if(token == 0){
+                token = ++tokens_m;
+            }
+            Int t = hint < triangle_count_m ? hint : 0;
+            for(size_t attempt = 0;; attempt++){
+                t = walk(p, t, token, claimed, rng);
+                const Triangle<Int>& start = delaunay_m.triangles_m[t];
+                for(Int v : start){
+                    if(v != infinite_vertex && delaunay_m.vertices_m[v] == p){
+                        release(claimed);
+                        return {v, t};
+                    }
+                }
+                cavity.assign(1, t);
+                boundary.clear();
+                bool conflict = false;
+                for(size_t i = 0; i < cavity.size() && !conflict; i++){
+                    const Triangle<Int>& c = delaunay_m.triangles_m[cavity[i]];
+                    for(Int k = 0; k < 3; k++){
+                        Int n = *c.neighbors()[k];
+                        if(std::ranges::find(cavity, n) != std::end(cavity)){
+                            continue;
+                        }
+                        if(!try_claim(n, token, claimed)){
+                            conflict = true;
+                            break;
+                        }
+                        const Triangle<Int>& nt = delaunay_m.triangles_m[n];
+                        if(delaunay_m.circumcircle_contains(nt, p)){
+                            cavity.push_back(n);
+                        }else{
+                            Int j = static_cast<Int>(std::ranges::find(nt.neighbors(), cavity[i]) - std::begin(nt.neighbors()));
+                            boundary.emplace_back(cavity[i], k, n, j);
+                        }
+                    }
+                }
+                if(conflict){
+                    release(claimed);
+                    retries_m++;
+                    for(size_t i = 0; i < std::min(attempt, size_t(6)); i++){
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+                // A cavity that is not a disk around p can only come from
+                // inconsistent predicates
+                if(boundary.size() != cavity.size() + 2){
+                    release(claimed);
+                    throw std::runtime_error("Cavity of a concurrent insertion is not a disk");
+                }
+                const Int v = static_cast<Int>(vertex_count_m++);
+                if(v >= vertex_end_m){
+                    release(claimed);
+                    throw std::length_error("Concurrent insertion exceeds the reserved number of points");
                 }
-                it++;
+                delaunay_m.vertices_m[v] = p;
+                const Int extra = static_cast<Int>(triangle_count_m.fetch_add(2));
+                star.clear();
+                for(const auto& [c, k, n, j] : boundary){
+                    Triangle<Int> nt = delaunay_m.triangles_m[c];
+                    nt.vertices()[k] = v;
+                    nt.neighbors()[k] = n;
+                    star.push_back(nt);
+                }
+                auto slot = [&](const size_t i) {return i < cavity.size() ? cavity[i] : extra + static_cast<Int>(i - cavity.size());};
+                // The edge opposite the second corner of a star triangle is
+                // shared with the star triangle starting at its third corner,
+                // and the other way around.
+                for(size_t i = 0; i < star.size(); i++){
+                    Int k = std::get<1>(boundary[i]);
+                    Int a = star[i].vertices()[(k + 1) % 3], b = star[i].vertices()[(k + 2) % 3];
+                    for(size_t l = 0; l < star.size(); l++){
+                        Int kl = std::get<1>(boundary[l]);
+                        if(star[l].vertices()[(kl + 1) % 3] == b){
+                            star[i].neighbors()[(k + 1) % 3] = slot(l);
+                        }
+                        if(star[l].vertices()[(kl + 2) % 3] == a){
+                            star[i].neighbors()[(k + 2) % 3] = slot(l);
+                        }
+                    }
+                }
+                for(size_t i = 0; i < star.size(); i++){
+                    const auto& [c, k, n, j] = boundary[i];
+                    delaunay_m.triangles_m[slot(i)] = star[i];
+                    delaunay_m.triangles_m[n].neighbors()[j] = slot(i);
+                }
+                release(claimed);
+                delaunay_m.instrumentation_m.count(Counter::insertions);
+                delaunay_m.instrumentation_m.record(Distribution::cavity_size, cavity.size());
+                return {v, slot(0)};
             }
         }
-        // Remove the vertices of t0
-        vertices_m.erase(std::begin(vertices_m), std::begin(vertices_m) + 3);
+
+        // Insertions that had to start over because of a conflict
+        size_t retries() const
+        {
+            return retries_m;
+        }
+    };
+
+    ConcurrentInserter concurrent_inserter(const size_t points)
+    {
+        return ConcurrentInserter(*this, points);
     }
 };
 
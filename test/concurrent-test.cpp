@@ -0,0 +1,77 @@
+#include <numeric>
+#include <thread>
+#include "test-helpers.h"
+
+namespace{
+
+// Inserts the points into d from the given number of threads, each taking
+// every threads-th point. Returns the vertex index of every point.
+std::vector<Int> insert_concurrently(Delaunay<Float, Int>& d, std::span<const Vertex<Float>> points, const unsigned threads)
+{
+    std::vector<Int> res(points.size());
+    auto inserter = d.concurrent_inserter(points.size());
+    {
+        std::vector<std::jthread> workers;
+        for(unsigned k = 0; k < threads; k++){
+            workers.emplace_back([&, k]()
+                {
+                    Int hint = 0;
+                    for(size_t i = k; i < points.size(); i += threads){
+                        auto [v, t] = inserter.insert(points[i], hint);
+                        res[i] = v;
+                        hint = t;
+                    }
+                });
+        }
+    }
+    return res;
+}
+
+}
+
+TEST(ConcurrentInserter, MatchesSerialTriangulation)
+{
+    const auto points = uniform_points(20000, 8);
+    const size_t seed = 100;
+    Delaunay<Float, Int> serial;
+    serial.triangulate(points);
+
+    Delaunay<Float, Int> d;
+    d.triangulate(std::vector(std::begin(points), std::begin(points) + seed));
+    const auto indices = insert_concurrently(d, std::span(points).subspan(seed), 4);
+
+    ASSERT_EQ(d.triangle_count(), serial.triangle_count());
+    expect_delaunay(d);
+    // Points in general position have a unique Delaunay triangulation, so
+    // with the vertices numbered as in the serial one the triangles agree
+    std::vector<Int> serial_index(points.size());
+    std::iota(std::begin(serial_index), std::begin(serial_index) + seed, Int(0));
+    for(size_t i = 0; i < indices.size(); i++){
+        serial_index[indices[i]] = static_cast<Int>(seed + i);
+    }
+    auto renumbered = d.triangles();
+    for(auto& t : renumbered){
+        for(auto& v : t.vertices()){
+            v = serial_index[v];
+        }
+    }
+    EXPECT_EQ(triangle_set(renumbered), triangle_set(serial.triangles_view()));
+}
+
+TEST(ConcurrentInserter, ReturnsExistingVertexForDuplicates)
+{
+    const auto points = uniform_points(2000, 9);
+    Delaunay<Float, Int> serial;
+    serial.triangulate(points);
+
+    // The first half is already in the triangulation
+    Delaunay<Float, Int> d;
+    d.triangulate(std::vector(std::begin(points), std::begin(points) + 1000));
+    const auto indices = insert_concurrently(d, points, 4);
+    for(Int i = 0; i < 1000; i++){
+        EXPECT_EQ(indices[i], i);
+    }
+    EXPECT_EQ(d.vertices().size(), points.size());
+    EXPECT_EQ(d.triangle_count(), serial.triangle_count());
+    expect_delaunay(d);
+}
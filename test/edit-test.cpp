@@ -0,0 +1,178 @@
+#include <functional>
+#include <set>
+#include "test-helpers.h"
+
+namespace{
+
+using Position = std::function<Vertex<Float>(std::mt19937_64&)>;
+
+std::set<Int> triangulated_vertices(const Delaunay<Float, Int>& d)
+{
+    std::set<Int> res;
+    for(const auto& t : d.triangles_view()){
+        res.insert(std::begin(t), std::end(t));
+    }
+    return res;
+}
+
+// Random removals, moves and insertions, each followed by checking that the
+// triangulation is Delaunay over exactly the vertices that should be in it.
+// New positions come from position, retried until unoccupied.
+void edit_randomly(const std::vector<Vertex<Float>>& points, const Position& position, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    std::vector<Vertex<Float>> where = points;
+    std::set<Int> live;
+    for(Int v = 0; v < points.size(); v++){
+        live.insert(v);
+    }
+    auto free_position = [&]()
+        {
+            while(true){
+                const auto p = position(rng);
+                if(std::ranges::none_of(live, [&](const Int v) {return where[v] == p;})){
+                    return p;
+                }
+            }
+        };
+    for(size_t step = 0; step < 200; step++){
+        const Int v = std::uniform_int_distribution<Int>(0, static_cast<Int>(where.size() - 1))(rng);
+        switch(rng() % 3){
+        case 0:
+            if(live.size() > 10){
+                ASSERT_EQ(d.remove(v), live.contains(v)) << "step " << step;
+                ASSERT_FALSE(d.remove(v)) << "step " << step;
+                live.erase(v);
+            }
+            break;
+        case 1:{
+            const auto p = free_position();
+            d.move(v, p);
+            where[v] = p;
+            live.insert(v);
+            break;
+        }
+        default:{
+            const auto p = free_position();
+            ASSERT_EQ(d.insert(std::span(&p, 1)), std::vector{static_cast<Int>(where.size())}) << "step " << step;
+            live.insert(static_cast<Int>(where.size()));
+            where.push_back(p);
+        }
+        }
+        expect_delaunay(d);
+        ASSERT_EQ(triangulated_vertices(d), live) << "step " << step;
+        std::vector<Vertex<Float>> remaining;
+        for(const Int u : live){
+            remaining.push_back(where[u]);
+        }
+        Delaunay<Float, Int> fresh;
+        fresh.triangulate(remaining);
+        ASSERT_EQ(d.triangle_count(), fresh.triangle_count()) << "step " << step;
+    }
+}
+
+}
+
+TEST(Editing, RandomSequenceOnUniformPoints)
+{
+    edit_randomly(uniform_points(300, 16), [](std::mt19937_64& rng)
+        {
+            std::uniform_real_distribution<Float> unit(0, 1);
+            return Vertex<Float>{unit(rng), unit(rng)};
+        }, 1);
+}
+
+TEST(Editing, RandomSequenceOnGrid)
+{
+    // Moves and insertions stay on a larger grid, keeping cocircular points
+    edit_randomly(grid_points(12), [](std::mt19937_64& rng)
+        {
+            std::uniform_int_distribution<int> coordinate(-2, 14);
+            return Vertex<Float>{static_cast<Float>(coordinate(rng)), static_cast<Float>(coordinate(rng))};
+        }, 2);
+}
+
+TEST(Editing, RemoveReturnsWhetherVertexWasTriangulated)
+{
+    auto points = uniform_points(100, 17);
+    points.push_back(points[5]);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    EXPECT_FALSE(d.remove(100));
+    EXPECT_TRUE(d.remove(5));
+    EXPECT_FALSE(d.remove(5));
+    EXPECT_THROW(d.remove(101), std::out_of_range);
+    expect_delaunay(d);
+}
+
+TEST(Editing, InsertBatchesMatchTriangulate)
+{
+    const auto points = uniform_points(2000, 18);
+    Delaunay<Float, Int> d;
+    d.triangulate(std::vector(std::begin(points), std::begin(points) + 500));
+    for(size_t begin = 500; begin < points.size(); begin += 500){
+        const auto indices = d.insert(std::span(points).subspan(begin, 500));
+        for(size_t i = 0; i < indices.size(); i++){
+            ASSERT_EQ(indices[i], begin + i);
+        }
+        expect_delaunay(d);
+    }
+    Delaunay<Float, Int> serial;
+    serial.triangulate(points);
+    EXPECT_EQ(triangle_set(d.triangles_view()), triangle_set(serial.triangles_view()));
+}
+
+TEST(Editing, InsertBatchOnGrid)
+{
+    const auto points = grid_points(20);
+    std::vector<Vertex<Float>> even, odd;
+    for(const auto& p : points){
+        (static_cast<int>(p.x() + p.y()) % 2 == 0 ? even : odd).push_back(p);
+    }
+    Delaunay<Float, Int> d, serial;
+    d.triangulate(even);
+    d.insert(odd);
+    serial.triangulate(points);
+    expect_delaunay(d);
+    EXPECT_EQ(d.triangle_count(), serial.triangle_count());
+}
+
+TEST(Editing, InsertBatchMapsDuplicatesToExistingVertices)
+{
+    const auto points = uniform_points(200, 19);
+    Delaunay<Float, Int> d;
+    d.triangulate(std::vector(std::begin(points), std::begin(points) + 100));
+    // Points already present, new points, and repeats of the new points
+    std::vector<Vertex<Float>> batch(std::begin(points) + 50, std::end(points));
+    batch.insert(std::end(batch), std::begin(points) + 150, std::end(points));
+    const auto indices = d.insert(batch);
+    ASSERT_EQ(indices.size(), batch.size());
+    const auto vertices = d.vertices();
+    const auto used = triangulated_vertices(d);
+    for(size_t i = 0; i < batch.size(); i++){
+        EXPECT_EQ(vertices[indices[i]], batch[i]);
+        EXPECT_TRUE(used.contains(indices[i]));
+    }
+    for(Int i = 0; i < 50; i++){
+        EXPECT_EQ(indices[i], 50 + i);
+    }
+    for(Int i = 0; i < 50; i++){
+        EXPECT_EQ(indices[150 + i], indices[100 + i]);
+    }
+    EXPECT_EQ(used.size(), points.size());
+    expect_delaunay(d);
+}
+
+TEST(Editing, InsertBatchAfterCollinearPoints)
+{
+    Delaunay<Float, Int> d;
+    d.triangulate(std::vector<Vertex<Float>>{{0, 0}, {1, 1}, {2, 2}});
+    ASSERT_EQ(d.triangle_count(), 0);
+    const std::vector<Vertex<Float>> batch{{1, 1}, {0, 2}, {2, 0}};
+    const auto indices = d.insert(batch);
+    EXPECT_EQ(indices, (std::vector<Int>{1, 4, 5}));
+    EXPECT_EQ(d.triangle_count(), 4);
+    expect_delaunay(d);
+}
@@ -0,0 +1,186 @@
+#include "test-helpers.h"
+
+namespace{
+
+struct Configuration{
+    Engine engine;
+    unsigned threads;
+};
+
+const std::vector<Configuration> configurations{
+    {Engine::incremental, 1},
+    {Engine::divide_and_conquer, 1},
+    {Engine::sweep_hull, 1},
+    // The partitioned construction, merging strips built in parallel. It
+    // takes at least 4096 points per thread, fewer are triangulated serially.
+    {Engine::divide_and_conquer, 2},
+    {Engine::divide_and_conquer, 3},
+};
+
+// Triangulates the points with every engine and thread count, checking
+// that each result is Delaunay and has the given number of triangles. The
+// number only depends on the points, even where cocircular points leave the
+// triangles free.
+void expect_engines_agree(const std::vector<Vertex<Float>>& points, const size_t triangles)
+{
+    for(const auto& [engine, threads] : configurations){
+        SCOPED_TRACE("engine " + std::to_string(static_cast<int>(engine)) + ", " + std::to_string(threads) + " threads");
+        Delaunay<Float, Int> d;
+        d.threads(threads);
+        d.triangulate(points, engine);
+        expect_delaunay(d);
+        EXPECT_EQ(d.triangle_count(), triangles);
+    }
+}
+
+// Triangles of the incremental engine, which the others are compared with
+size_t reference_count(const std::vector<Vertex<Float>>& points)
+{
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    return d.triangle_count();
+}
+
+// The integer points on the circle of radius 1105, which has 108 of them,
+// all exactly cocircular. Too few to be split between threads.
+std::vector<Vertex<Float>> circle_points()
+{
+    constexpr long r = 1105;
+    std::vector<Vertex<Float>> res;
+    for(long x = -r; x <= r; x++){
+        for(long y = -r; y <= r; y++){
+            if(x*x + y*y == r*r){
+                res.push_back({static_cast<Float>(x), static_cast<Float>(y)});
+            }
+        }
+    }
+    return res;
+}
+
+}
+
+TEST(Engines, UniformPoints)
+{
+    const auto points = uniform_points(12500, 5);
+    expect_engines_agree(points, reference_count(points));
+}
+
+TEST(Engines, Grid)
+{
+    // 2 triangles per unit square
+    expect_engines_agree(grid_points(112), 2*111*111);
+}
+
+TEST(Engines, CocircularPoints)
+{
+    const auto points = circle_points();
+    ASSERT_EQ(points.size(), 108);
+    expect_engines_agree(points, points.size() - 2);
+}
+
+TEST(Engines, Duplicates)
+{
+    auto points = uniform_points(9000, 6);
+    const auto repeats = std::vector(std::begin(points), std::begin(points) + 3500);
+    points.insert(std::end(points), std::begin(repeats), std::end(repeats));
+    expect_engines_agree(points, reference_count(std::vector(std::begin(points), std::begin(points) + 9000)));
+}
+
+TEST(Engines, CollinearPoints)
+{
+    std::vector<Vertex<Float>> points;
+    for(int i = 0; i < 12500; i++){
+        points.push_back({static_cast<Float>(3*i), static_cast<Float>(-i)});
+    }
+    expect_engines_agree(points, 0);
+}
+
+TEST(Engines, StridedCoordinates)
+{
+    // Every point followed by a value that is not one of its coordinates,
+    // the last point without it
+    const auto points = uniform_points(1000, 7);
+    std::vector<Float> coordinates;
+    for(const auto& p : points){
+        coordinates.insert(std::end(coordinates), {p.x(), p.y(), -1});
+    }
+    coordinates.pop_back();
+    Delaunay<Float, Int> d, e;
+    d.triangulate(points);
+    e.triangulate(coordinates, 3);
+    EXPECT_EQ(e.vertices(), points);
+    EXPECT_EQ(triangle_set(e.triangles_view()), triangle_set(d.triangles_view()));
+    for(const size_t stride : {0, 1}){
+        EXPECT_THROW(e.triangulate(coordinates, stride), std::invalid_argument) << "stride " << stride;
+    }
+}
+
+TEST(Engines, BrioInsertionOrder)
+{
+    // Points in general position have one Delaunay triangulation, which
+    // inserting in BRIO order must give with the vertices numbered as given
+    const auto points = uniform_points(5000, 8);
+    Delaunay<Float, Int> given, brio;
+    given.insertion_order(InsertionOrder::given);
+    given.triangulate(points);
+    brio.insertion_order(InsertionOrder::brio);
+    brio.triangulate(points);
+    EXPECT_EQ(brio.vertices(), points);
+    expect_delaunay(brio);
+    EXPECT_EQ(triangle_set(brio.triangles_view()), triangle_set(given.triangles_view()));
+    // Cocircular points leave the triangles free, but not their number
+    brio.triangulate(grid_points(30));
+    EXPECT_EQ(brio.vertices(), grid_points(30));
+    expect_delaunay(brio);
+    EXPECT_EQ(brio.triangle_count(), 2*29*29);
+}
+
+TEST(Engines, JumpAndWalk)
+{
+    // Points in random order, so that walks from the last triangle cross
+    // about sqrt(n) triangles, and sampled starts about n^(1/3) of them
+    const auto points = uniform_points(5000, 9);
+    Delaunay<Float, Int> last, jump;
+    last.triangulate(points);
+    jump.walk_start(WalkStart::jump_and_walk);
+    jump.triangulate(points);
+    expect_delaunay(jump);
+    EXPECT_EQ(triangle_set(jump.triangles_view()), triangle_set(last.triangles_view()));
+    // One walk per vertex but the first triangle's
+    const auto& walks = jump.walk_statistics();
+    EXPECT_EQ(walks.walks, points.size() - 3);
+    EXPECT_EQ(walks.walks, jump.flip_statistics().insertions);
+    EXPECT_GT(walks.steps, 0);
+    EXPECT_GE(walks.max_steps, walks.mean_steps());
+    EXPECT_LE(walks.max_steps, walks.steps);
+    EXPECT_LT(walks.mean_steps(), last.walk_statistics().mean_steps());
+    jump.reset_walk_statistics();
+    EXPECT_EQ(jump.walk_statistics().walks, 0);
+    EXPECT_EQ(jump.walk_statistics().steps, 0);
+}
+
+TEST(Engines, FlipStatistics)
+{
+    // Inserted row by row, each vertex of the grid is first joined to
+    // vertices of the rows below, which flips replace
+    auto points = grid_points(30);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    const auto& flips = d.flip_statistics();
+    EXPECT_EQ(flips.insertions, points.size() - 3);
+    EXPECT_GT(flips.flips, 0);
+    EXPECT_GE(flips.max_flips, flips.mean_flips());
+    EXPECT_LE(flips.max_flips, flips.flips);
+    d.reset_flip_statistics();
+    EXPECT_EQ(flips.insertions, 0);
+    EXPECT_EQ(flips.flips, 0);
+    // Duplicates are found by the walk and not inserted
+    points.insert(std::end(points), std::begin(points), std::begin(points) + 100);
+    d.triangulate(points);
+    EXPECT_EQ(flips.insertions, 30*30 - 3);
+    // Vertices inserted into a triangulation are counted too
+    const auto more = uniform_points(50, 10);
+    d.insert(more);
+    EXPECT_EQ(flips.insertions, 30*30 - 3 + more.size());
+    expect_delaunay(d);
+}
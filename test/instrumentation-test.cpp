@@ -0,0 +1,200 @@
+#include <numeric>
+#include <sstream>
+#include "test-helpers.h"
+
+namespace{
+
+using Instrumented = Delaunay<Float, Int, Instrumentation>;
+
+// Recursive descent over a JSON value, collecting the strings it holds.
+// Returns false at the first character that breaks the grammar.
+class JsonReader{
+private:
+    std::string_view text_m;
+    size_t at_m = 0;
+
+    void skip_space()
+    {
+        while(at_m < text_m.size() && std::string_view(" \t\n\r").find(text_m[at_m]) != std::string_view::npos){
+            at_m++;
+        }
+    }
+
+    bool take(const char c)
+    {
+        skip_space();
+        if(at_m < text_m.size() && text_m[at_m] == c){
+            at_m++;
+            return true;
+        }
+        return false;
+    }
+
+    bool string()
+    {
+        if(!take('"')){
+            return false;
+        }
+        const size_t begin = at_m;
+        while(at_m < text_m.size() && text_m[at_m] != '"'){
+            at_m += text_m[at_m] == '\\' ? 2 : 1;
+        }
+        if(at_m >= text_m.size()){
+            return false;
+        }
+        strings.emplace_back(text_m.substr(begin, at_m - begin));
+        at_m++;
+        return true;
+    }
+
+    bool number()
+    {
+        skip_space();
+        const size_t begin = at_m;
+        while(at_m < text_m.size() && std::string_view("+-.0123456789eE").find(text_m[at_m]) != std::string_view::npos){
+            at_m++;
+        }
+        return at_m > begin;
+    }
+
+    template<class Item>
+    bool sequence(const char close, Item item)
+    {
+        if(take(close)){
+            return true;
+        }
+        do{
+            if(!item()){
+                return false;
+            }
+        }while(take(','));
+        return take(close);
+    }
+
+    bool value()
+    {
+        skip_space();
+        if(at_m >= text_m.size()){
+            return false;
+        }
+        if(text_m[at_m] == '"'){
+            return string();
+        }
+        if(take('{')){
+            return sequence('}', [this] {return string() && take(':') && value();});
+        }
+        if(take('[')){
+            return sequence(']', [this] {return value();});
+        }
+        return number();
+    }
+public:
+    std::vector<std::string> strings;
+
+    explicit JsonReader(const std::string_view text)
+     : text_m(text)
+    {}
+
+    // Whether the whole text is one JSON value
+    bool read()
+    {
+        const bool res = value();
+        skip_space();
+        return res && at_m == text_m.size();
+    }
+};
+
+// Checks the counters against the statistics Delaunay keeps itself, which
+// count the same walks, flips and insertions
+void expect_counters(const Instrumented& d, const std::vector<Vertex<Float>>& points)
+{
+    const auto& stats = d.instrumentation().stats();
+    const auto walks = d.walk_statistics();
+    const auto flips = d.flip_statistics();
+    EXPECT_EQ(stats[Counter::walks], walks.walks);
+    EXPECT_EQ(stats[Counter::walk_steps], walks.steps);
+    EXPECT_EQ(stats[Counter::flips], flips.flips);
+    EXPECT_EQ(stats[Counter::insertions], flips.insertions);
+    // The first triangle's three vertices are not inserted
+    EXPECT_EQ(flips.insertions, points.size() - 3);
+    EXPECT_GT(stats[Counter::walk_steps], 0);
+    EXPECT_GT(stats[Counter::orientation_tests], 0);
+    EXPECT_GT(stats[Counter::incircle_tests], 0);
+    // Every triangle still held was allocated, ghosts included
+    EXPECT_EQ(stats[Counter::triangle_allocations] - stats[Counter::triangle_releases], d.view().triangle_slots().size());
+    EXPECT_EQ(stats[Distribution::flips_per_insertion].count, flips.insertions);
+    EXPECT_EQ(stats[Distribution::flips_per_insertion].sum, flips.flips);
+    EXPECT_EQ(stats[Distribution::flips_per_insertion].max, flips.max_flips);
+    EXPECT_EQ(stats[Distribution::insertion_nanoseconds].count, flips.insertions);
+}
+
+}
+
+TEST(Instrumentation, CountersMatchStatistics)
+{
+    for(const auto& points : {uniform_points(2000, 30), grid_points(40)}){
+        Instrumented d;
+        d.triangulate(points, Engine::incremental);
+        expect_counters(d, points);
+        EXPECT_GT(d.flip_statistics().flips, 0);
+        // Both start again from zero
+        d.instrumentation().reset();
+        d.reset_walk_statistics();
+        d.reset_flip_statistics();
+        d.triangulate(points, Engine::incremental);
+        expect_counters(d, points);
+    }
+}
+
+TEST(Instrumentation, PhasesAreTimed)
+{
+    Instrumented d;
+    d.triangulate(uniform_points(2000, 31), Engine::incremental);
+    const auto& stats = d.instrumentation().stats();
+    for(const auto phase : {Phase::triangulate, Phase::incremental, Phase::compact}){
+        EXPECT_EQ(stats.phase_runs[static_cast<size_t>(phase)], 1) << phase_names[static_cast<size_t>(phase)];
+        EXPECT_GT(stats.seconds(phase), 0) << phase_names[static_cast<size_t>(phase)];
+    }
+    // Nested phases count towards the enclosing one
+    EXPECT_GE(stats.seconds(Phase::triangulate), stats.seconds(Phase::incremental));
+    EXPECT_EQ(stats.phase_runs[static_cast<size_t>(Phase::sweep_hull)], 0);
+    d.triangulate(uniform_points(2000, 32), Engine::sweep_hull);
+    EXPECT_EQ(stats.phase_runs[static_cast<size_t>(Phase::triangulate)], 2);
+    EXPECT_EQ(stats.phase_runs[static_cast<size_t>(Phase::sweep_hull)], 1);
+    EXPECT_GT(stats.seconds(Phase::sweep_hull), 0);
+}
+
+TEST(Instrumentation, TraceIsJson)
+{
+    Instrumented d;
+    d.triangulate(uniform_points(500, 33), Engine::incremental);
+    d.remove(3);
+    std::ostringstream os;
+    d.instrumentation().write_trace(os);
+    const auto trace = os.str();
+    JsonReader json(trace);
+    ASSERT_TRUE(json.read()) << trace;
+    auto contains = [&json](const std::string_view s) {return std::ranges::find(json.strings, s) != std::end(json.strings);};
+    for(const std::string_view name : {"traceEvents", "displayTimeUnit", "dropped_events", "triangulate", "incremental", "compact", "remove", "counters"}){
+        EXPECT_TRUE(contains(name)) << name;
+    }
+    for(const auto name : counter_names){
+        EXPECT_TRUE(contains(name)) << name;
+    }
+    EXPECT_FALSE(contains("voronoi"));
+
+    // Events beyond the capacity are dropped, and the trace stays valid
+    d.instrumentation().reset();
+    d.instrumentation().trace_capacity(0);
+    d.triangulate(uniform_points(500, 34), Engine::incremental);
+    std::ostringstream dropped;
+    d.instrumentation().write_trace(dropped);
+    const auto empty_trace = dropped.str();
+    JsonReader empty(empty_trace);
+    ASSERT_TRUE(empty.read()) << empty_trace;
+    EXPECT_EQ(std::ranges::find(empty.strings, "triangulate"), std::end(empty.strings));
+    const auto& runs = d.instrumentation().stats().phase_runs;
+    const auto events = std::accumulate(std::begin(runs), std::end(runs), uint64_t(0));
+    EXPECT_GT(events, 0);
+    EXPECT_NE(empty_trace.find("\"dropped_events\":" + std::to_string(events)), std::string::npos) << empty_trace;
+}
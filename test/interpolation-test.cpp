@@ -0,0 +1,130 @@
+#include "test-helpers.h"
+
+namespace{
+
+constexpr size_t components = 2;
+
+// Two linear fields, which both methods reproduce
+std::array<Float, components> field(const Vertex<Float>& p)
+{
+    return {2 + 3*p.x() - 5*p.y(), -1 + p.x()/2 + p.y()/4};
+}
+
+std::vector<Float> field_values(const std::vector<Vertex<Float>>& points)
+{
+    std::vector<Float> res;
+    for(const auto& p : points){
+        const auto f = field(p);
+        res.insert(std::end(res), std::begin(f), std::end(f));
+    }
+    return res;
+}
+
+// Uniform points and the corners of the unit square, which is then the
+// convex hull
+std::vector<Vertex<Float>> square_points(const size_t n, const uint64_t seed)
+{
+    auto res = uniform_points(n, seed);
+    res.insert(std::end(res), {{0, 0}, {1, 0}, {0, 1}, {1, 1}});
+    return res;
+}
+
+bool in_square(const Vertex<Float>& p)
+{
+    return p.x() >= 0 && p.x() <= 1 && p.y() >= 0 && p.y() <= 1;
+}
+
+// Checks the interpolated values at p, or that p got outside if it lies
+// outside the unit square
+void expect_field(const Vertex<Float>& p, std::span<const Float> out, const Float outside)
+{
+    const auto f = field(p);
+    for(size_t c = 0; c < components; c++){
+        if(!in_square(p)){
+            EXPECT_EQ(out[c], outside) << "point (" << p.x() << ", " << p.y() << ")";
+        }else{
+            EXPECT_NEAR(out[c], f[c], 1e-12) << "point (" << p.x() << ", " << p.y() << ")";
+        }
+    }
+}
+
+}
+
+TEST(Interpolation, LinearFieldAtPoints)
+{
+    const auto points = square_points(500, 19);
+    const auto values = field_values(points);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    d.threads(4);
+    // Points in and around the square, and at vertices
+    auto qs = uniform_points(300, 20);
+    for(auto& q : qs){
+        q = {2*q.x() - 0.5, 2*q.y() - 0.5};
+    }
+    qs.insert(std::end(qs), std::begin(points), std::begin(points) + 20);
+    std::vector<Float> out(components*qs.size());
+    for(const auto method : {Interpolation::linear, Interpolation::natural_neighbor}){
+        d.interpolate<Float>(values, components, qs, out, method, -7);
+        for(size_t i = 0; i < qs.size(); i++){
+            expect_field(qs[i], std::span(out).subspan(components*i, components), -7);
+        }
+        // Not a number outside by default
+        d.interpolate<Float>(values, components, qs, out, method);
+        for(size_t i = 0; i < qs.size(); i++){
+            EXPECT_EQ(std::isnan(out[components*i]), !in_square(qs[i])) << "query " << i;
+        }
+    }
+}
+
+TEST(Interpolation, LinearFieldOnGrid)
+{
+    // No grid point lies on the square's edges, where rounding would decide
+    // between inside and outside
+    const auto points = square_points(500, 21);
+    const auto values = field_values(points);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    d.threads(3);
+    const Grid<Float> grid{-0.23, -0.27, 0.1, 0.1, 15, 16};
+    std::vector<Float> out(components*grid.size());
+    for(const auto method : {Interpolation::linear, Interpolation::natural_neighbor}){
+        d.interpolate<Float>(values, components, grid, out, method, -7);
+        for(size_t j = 0; j < grid.ny; j++){
+            for(size_t i = 0; i < grid.nx; i++){
+                expect_field(grid(i, j), std::span(out).subspan(components*(j*grid.nx + i), components), -7);
+            }
+        }
+    }
+}
+
+TEST(Interpolation, LinearFieldOnCocircularPoints)
+{
+    // Natural neighbor cavities on a grid hold four cocircular vertices
+    const auto points = grid_points(10);
+    const auto values = field_values(points);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    const Grid<Float> grid{0.05, 0.15, 0.7, 0.45, 13, 20};
+    std::vector<Float> out(components*grid.size());
+    for(const auto method : {Interpolation::linear, Interpolation::natural_neighbor}){
+        d.interpolate<Float>(values, components, grid, out, method);
+        for(size_t k = 0; k < grid.size(); k++){
+            const auto f = field(grid(k % grid.nx, k / grid.nx));
+            for(size_t c = 0; c < components; c++){
+                EXPECT_NEAR(out[components*k + c], f[c], 1e-12) << "grid point " << k;
+            }
+        }
+    }
+}
+
+TEST(Interpolation, ShortBuffersThrow)
+{
+    const auto points = square_points(50, 22);
+    const auto values = field_values(points);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    std::vector<Float> out(components*points.size());
+    EXPECT_THROW(d.interpolate<Float>(std::span(values).first(values.size() - 1), components, points, out), std::length_error);
+    EXPECT_THROW(d.interpolate<Float>(values, components, points, std::span(out).first(out.size() - 1)), std::length_error);
+}
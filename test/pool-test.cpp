@@ -0,0 +1,120 @@
+#include <map>
+#include "test-helpers.h"
+
+namespace{
+
+using Pool = TrianglePool<Int>;
+
+// Triangle i of a strip, {i, i + 1, i + 2}, linked to triangle i - 1
+// opposite its last vertex and to triangle i + 1 opposite its first
+Triangle<Int> strip_triangle(const Int i, const Int n)
+{
+    Triangle<Int> res({i, i + 1, i + 2});
+    if(i + 1 < n){
+        res.neighbors()[0] = i + 1;
+    }
+    if(i > 0){
+        res.neighbors()[2] = i - 1;
+    }
+    return res;
+}
+
+// The live triangles by their vertices, with the vertices of their
+// neighbors, which compacting must keep whatever the slots
+using Links = std::map<std::array<Int, 3>, std::array<std::optional<std::array<Int, 3>>, 3>>;
+
+Links links(const Pool& pool)
+{
+    Links res;
+    for(Int t = 0; t < pool.size(); t++){
+        if(!pool.alive(t)){
+            continue;
+        }
+        auto& around = res[pool[t].vertices()];
+        for(size_t k = 0; k < 3; k++){
+            if(const auto n = pool[t].neighbors()[k]){
+                EXPECT_TRUE(pool.alive(*n)) << "triangle " << t;
+                around[k] = pool[*n].vertices();
+            }
+        }
+    }
+    return res;
+}
+
+}
+
+TEST(TrianglePool, ReusesReleasedSlots)
+{
+    constexpr Int n = 8;
+    Pool pool;
+    for(Int i = 0; i < n; i++){
+        EXPECT_EQ(pool.allocate(strip_triangle(i, n)), i);
+    }
+    pool.release(2);
+    pool.release(5);
+    pool.release(5);
+    EXPECT_FALSE(pool.alive(2));
+    EXPECT_FALSE(pool.alive(5));
+    EXPECT_EQ(pool.size(), n);
+    EXPECT_EQ(pool.live(), n - 2);
+    // The slot released last is handed out first, then a new one
+    EXPECT_EQ(pool.allocate(Triangle<Int>({100, 101, 102})), 5);
+    EXPECT_EQ(pool.allocate(Triangle<Int>({103, 104, 105})), 2);
+    EXPECT_EQ(pool.allocate(Triangle<Int>({106, 107, 108})), n);
+    EXPECT_TRUE(pool.alive(2));
+    EXPECT_TRUE(pool.alive(5));
+    EXPECT_EQ(pool.size(), n + 1);
+    EXPECT_EQ(pool.live(), n + 1);
+}
+
+TEST(TrianglePool, CompactRemapsNeighbors)
+{
+    constexpr Int n = 12;
+    Pool pool;
+    for(Int i = 0; i < n; i++){
+        pool.allocate(strip_triangle(i, n));
+    }
+    // Cut the strip at 3 and 7, unlinking the triangles next to them
+    for(const Int t : {3, 7}){
+        pool.release(t);
+        pool[t - 1].neighbors()[0] = OptionalIndex<Int>();
+        pool[t + 1].neighbors()[2] = OptionalIndex<Int>();
+    }
+    // A triangle in slot 7 taking the place of the old one, and one in slot
+    // 3 linked to the strip's start
+    const Int u = pool.allocate(Triangle<Int>({50, 51, 52}));
+    ASSERT_EQ(u, 7);
+    pool[u].neighbors() = {6, OptionalIndex<Int>(), 8};
+    pool[6].neighbors()[0] = u;
+    pool[8].neighbors()[2] = u;
+    const Int w = pool.allocate(Triangle<Int>({60, 61, 62}));
+    ASSERT_EQ(w, 3);
+    pool[w].neighbors()[1] = 0;
+    pool[0].neighbors()[1] = w;
+    // And a slot left released
+    pool.release(10);
+    pool[9].neighbors()[0] = OptionalIndex<Int>();
+    pool[11].neighbors()[2] = OptionalIndex<Int>();
+
+    const auto before = links(pool);
+    ASSERT_EQ(before.size(), n - 1);
+    // Triangles with an odd first vertex go first
+    auto odd = [](const Triangle<Int>& t) {return t.vertices()[0] % 2 == 1;};
+    pool.compact(odd);
+    EXPECT_EQ(pool.size(), n - 1);
+    EXPECT_EQ(pool.live(), n - 1);
+    for(Int t = 0; t < pool.size(); t++){
+        EXPECT_TRUE(pool.alive(t));
+        EXPECT_EQ(odd(pool[t]), t < 4) << "triangle " << t;
+    }
+    // Keeping their order otherwise
+    EXPECT_EQ(pool[0].front(), 1);
+    EXPECT_EQ(pool[3].front(), 11);
+    EXPECT_EQ(pool[4].front(), 0);
+    EXPECT_EQ(pool[6].front(), 60);
+    EXPECT_EQ(pool[9].front(), 50);
+    EXPECT_EQ(pool[10].front(), 8);
+    EXPECT_EQ(links(pool), before);
+    // Slots are handed out after the compacted ones
+    EXPECT_EQ(pool.allocate(Triangle<Int>({70, 71, 72})), n - 1);
+}
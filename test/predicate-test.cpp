@@ -0,0 +1,185 @@
+#include "test-helpers.h"
+
+namespace{
+
+template<class F>
+int sign(const F v)
+{
+    return (v > 0) - (v < 0);
+}
+
+// c moved k representable values up, or down for negative k
+template<class F>
+F step(F c, const int k)
+{
+    for(int i = 0; i < std::abs(k); i++){
+        c = std::nextafter(c, k > 0 ? std::numeric_limits<F>::max() : std::numeric_limits<F>::lowest());
+    }
+    return c;
+}
+
+// Points (0.5 + i ulps, 0.5 + j ulps) against the line through (12, 12)
+// and (24, 24). orient2d is 12(y - x), so the sign is that of j - i, which
+// the floating point determinant gets wrong for most of them.
+template<class F>
+struct NearCollinear{
+    std::vector<F> px, py;
+    std::vector<int> expected;
+    static constexpr F qx = 12, qy = 12, rx = 24, ry = 24;
+
+    explicit NearCollinear(const int side = 32)
+    {
+        for(int j = 0; j < side; j++){
+            for(int i = 0; i < side; i++){
+                px.push_back(step(F(0.5), i));
+                py.push_back(step(F(0.5), j));
+                expected.push_back(sign(j - i));
+            }
+        }
+    }
+};
+
+// Points (1 + dx, 1 + dy) a few ulps from (1, 1), against the circle
+// through (0, 0), (1, 0) and (0, 1), which passes through (1, 1). The point
+// lies inside if dx + dy + dx^2 + dy^2 < 0, and the squares only matter
+// where dx + dy is zero.
+template<class F>
+struct NearCocircular{
+    std::vector<F> dx, dy;
+    std::vector<int> expected;
+    static constexpr F ax = 0, ay = 0, bx = 1, by = 0, cx = 0, cy = 1;
+
+    explicit NearCocircular(const int side = 32)
+    {
+        for(int j = -side/2; j < side/2; j++){
+            for(int i = -side/2; i < side/2; i++){
+                const F x = step(F(1), i), y = step(F(1), j);
+                // Exact, the differences being a few ulps of 1
+                const F ex = x - 1, ey = y - 1;
+                dx.push_back(x);
+                dy.push_back(y);
+                expected.push_back(ex + ey != 0 ? -sign(ex + ey) : (ex == 0 && ey == 0 ? 0 : -1));
+            }
+        }
+    }
+};
+
+template<class F>
+void expect_exact_orient2d()
+{
+    const NearCollinear<F> s;
+    for(size_t k = 0; k < s.expected.size(); k++){
+        EXPECT_EQ(sign(orient2d(s.px[k], s.py[k], s.qx, s.qy, s.rx, s.ry)), s.expected[k]) << "point " << k;
+        // Permuting the points flips or keeps the sign
+        EXPECT_EQ(sign(orient2d(s.qx, s.qy, s.px[k], s.py[k], s.rx, s.ry)), -s.expected[k]) << "point " << k;
+        EXPECT_EQ(sign(orient2d(s.rx, s.ry, s.px[k], s.py[k], s.qx, s.qy)), s.expected[k]) << "point " << k;
+    }
+}
+
+template<class F>
+void expect_exact_incircle()
+{
+    const NearCocircular<F> s;
+    for(size_t k = 0; k < s.expected.size(); k++){
+        EXPECT_EQ(sign(incircle(s.ax, s.ay, s.bx, s.by, s.cx, s.cy, s.dx[k], s.dy[k])), s.expected[k]) << "point " << k;
+        EXPECT_EQ(sign(incircle(s.bx, s.by, s.cx, s.cy, s.ax, s.ay, s.dx[k], s.dy[k])), s.expected[k]) << "point " << k;
+    }
+}
+
+// Random coordinates appended to the near-degenerate ones, so that batches
+// mix lanes the filter trusts with lanes recomputed exactly. The count is
+// not a multiple of any vector width, leaving a scalar tail.
+template<class F>
+void append_random(std::vector<F>& x, std::vector<F>& y, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<F> unit(-2, 2);
+    for(size_t i = 0; i < 37; i++){
+        x.push_back(unit(rng));
+        y.push_back(unit(rng));
+    }
+}
+
+template<class F>
+void expect_orient2d_batch()
+{
+    NearCollinear<F> s;
+    append_random(s.px, s.py, 1);
+    const size_t n = s.px.size();
+    std::vector<F> res(n);
+    // The fixed points in every lane, and the same points from arrays
+    orient2d_batch<F>({s.px.data(), s.py.data()}, {&s.qx, &s.qy, 0}, {&s.rx, &s.ry, 0}, n, res.data());
+    const std::vector<F> qx(n, s.qx), qy(n, s.qy);
+    std::vector<Vertex<F>> r(n, Vertex<F>{s.rx, s.ry});
+    std::vector<F> permuted(n);
+    orient2d_batch<F>({qx.data(), qy.data()}, {s.px.data(), s.py.data()}, BatchPoints<F>(r.data()), n, permuted.data());
+    for(size_t k = 0; k < n; k++){
+        EXPECT_EQ(sign(res[k]), sign(orient2d(s.px[k], s.py[k], s.qx, s.qy, s.rx, s.ry))) << "lane " << k;
+        EXPECT_EQ(sign(permuted[k]), -sign(res[k])) << "lane " << k;
+        if(k < s.expected.size()){
+            EXPECT_EQ(sign(res[k]), s.expected[k]) << "lane " << k;
+        }
+    }
+}
+
+template<class F>
+void expect_incircle_batch()
+{
+    NearCocircular<F> s;
+    append_random(s.dx, s.dy, 2);
+    const size_t n = s.dx.size();
+    std::vector<F> res(n);
+    incircle_batch<F>({&s.ax, &s.ay, 0}, {&s.bx, &s.by, 0}, {&s.cx, &s.cy, 0}, {s.dx.data(), s.dy.data()}, n, res.data());
+    for(size_t k = 0; k < n; k++){
+        EXPECT_EQ(sign(res[k]), sign(incircle(s.ax, s.ay, s.bx, s.by, s.cx, s.cy, s.dx[k], s.dy[k]))) << "lane " << k;
+        if(k < s.expected.size()){
+            EXPECT_EQ(sign(res[k]), s.expected[k]) << "lane " << k;
+        }
+    }
+}
+
+template<class F>
+void expect_circumcenter_batch()
+{
+    std::vector<F> x, y;
+    append_random(x, y, 3);
+    append_random(x, y, 4);
+    append_random(x, y, 5);
+    const size_t n = x.size()/3;
+    std::vector<F> cx(n), cy(n);
+    const auto at = [&](const size_t i) {return BatchPoints<F>(x.data() + i*n, y.data() + i*n);};
+    circumcenter_batch<F>(at(0), at(1), at(2), n, cx.data(), cy.data());
+    for(size_t k = 0; k < n; k++){
+        const auto [ox, oy] = circumcenter(x[k], y[k], x[n + k], y[n + k], x[2*n + k], y[2*n + k]);
+        const F tolerance = 64*std::numeric_limits<F>::epsilon()*(1 + std::abs(ox) + std::abs(oy));
+        EXPECT_NEAR(cx[k], ox, tolerance) << "lane " << k;
+        EXPECT_NEAR(cy[k], oy, tolerance) << "lane " << k;
+    }
+}
+
+}
+
+TEST(Predicates, ExactOrient2dNearCollinear)
+{
+    expect_exact_orient2d<float>();
+    expect_exact_orient2d<double>();
+}
+
+TEST(Predicates, ExactIncircleNearCocircular)
+{
+    expect_exact_incircle<float>();
+    expect_exact_incircle<double>();
+}
+
+// The batched kernels run on the widest instruction set of this machine,
+// falling back to the scalar predicates on lanes the filter does not trust
+TEST(Predicates, BatchesAgreeWithScalarPredicates)
+{
+    SCOPED_TRACE("instruction set " + std::to_string(static_cast<int>(simd_support())));
+    expect_orient2d_batch<float>();
+    expect_orient2d_batch<double>();
+    expect_incircle_batch<float>();
+    expect_incircle_batch<double>();
+    expect_circumcenter_batch<float>();
+    expect_circumcenter_batch<double>();
+}
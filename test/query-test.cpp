@@ -0,0 +1,117 @@
+#include <set>
+#include "test-helpers.h"
+
+namespace{
+
+Float distance2(const Vertex<Float>& a, const Vertex<Float>& b)
+{
+    const Float dx = a.x() - b.x(), dy = a.y() - b.y();
+    return dx*dx + dy*dy;
+}
+
+// Squared distances from p to the triangulated vertices, closest first
+std::vector<Float> brute_force(const Delaunay<Float, Int>& d, const Vertex<Float>& p)
+{
+    std::set<Int> used;
+    for(const auto& t : d.triangles_view()){
+        used.insert(std::begin(t), std::end(t));
+    }
+    const auto vertices = d.vertices();
+    std::vector<Float> res;
+    for(const Int v : used){
+        res.push_back(distance2(vertices[v], p));
+    }
+    std::ranges::sort(res);
+    return res;
+}
+
+// Points in and around the box from lo to hi, some of them at vertices
+std::vector<Vertex<Float>> queries(const std::vector<Vertex<Float>>& points, const Float lo, const Float hi, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    const Float margin = (hi - lo)/4;
+    std::uniform_real_distribution<Float> around(lo - margin, hi + margin);
+    std::vector<Vertex<Float>> res(200);
+    for(auto& q : res){
+        q = {around(rng), around(rng)};
+    }
+    for(size_t i = 0; i < 20; i++){
+        res.push_back(points[rng() % points.size()]);
+    }
+    return res;
+}
+
+// Compares by distance, as vertices at the same distance may come in any
+// order
+void expect_nearest(const Delaunay<Float, Int>& d, std::span<const Vertex<Float>> qs, const size_t k)
+{
+    constexpr Int none = Delaunay<Float, Int>::infinite_vertex;
+    const auto vertices = d.vertices();
+    const auto nearest = d.nearest_vertex(qs);
+    const auto batch = d.k_nearest(qs, k);
+    ASSERT_EQ(batch.size(), k*qs.size());
+    for(size_t i = 0; i < qs.size(); i++){
+        const auto& q = qs[i];
+        const auto expected = brute_force(d, q);
+        EXPECT_DOUBLE_EQ(distance2(vertices[d.nearest_vertex(q)], q), expected[0]) << "query " << i;
+        EXPECT_DOUBLE_EQ(distance2(vertices[nearest[i]], q), expected[0]) << "query " << i;
+        const auto single = d.k_nearest(q, k);
+        const size_t found = std::min(k, expected.size());
+        ASSERT_EQ(single.size(), found) << "query " << i;
+        const auto padded = std::span(batch).subspan(k*i, k);
+        for(const auto& res : {std::span<const Int>(single), padded.first(found)}){
+            EXPECT_EQ(std::set(std::begin(res), std::end(res)).size(), found) << "query " << i;
+            for(size_t j = 0; j < found; j++){
+                EXPECT_DOUBLE_EQ(distance2(vertices[res[j]], q), expected[j]) << "query " << i << " neighbor " << j;
+            }
+        }
+        for(const Int v : padded.subspan(found)){
+            EXPECT_EQ(v, none) << "query " << i;
+        }
+    }
+}
+
+}
+
+TEST(Queries, NearestOnUniformPoints)
+{
+    const auto points = uniform_points(1000, 18);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    d.threads(4);
+    expect_nearest(d, queries(points, 0, 1, 1), 12);
+}
+
+TEST(Queries, NearestOnGrid)
+{
+    // Many vertices at the same distance, and queries on the grid lines
+    const auto points = grid_points(20);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    d.threads(4);
+    auto qs = queries(points, 0, 19, 2);
+    for(Float c = -1.5; c < 21; c += 2.5){
+        qs.push_back({c, 7});
+        qs.push_back({c + 0.5, c});
+    }
+    expect_nearest(d, qs, 16);
+}
+
+TEST(Queries, NearestSkipsRemovedVertices)
+{
+    const auto points = uniform_points(500, 19);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    for(Int v = 0; v < points.size(); v += 3){
+        d.remove(v);
+    }
+    expect_nearest(d, queries(points, 0, 1, 3), 8);
+}
+
+TEST(Queries, MoreNeighborsThanVertices)
+{
+    const std::vector<Vertex<Float>> points{{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0.5, 0.4}};
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    expect_nearest(d, queries(points, 0, 1, 4), 8);
+}
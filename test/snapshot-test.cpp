@@ -0,0 +1,150 @@
+#include <sstream>
+#include "test-helpers.h"
+
+namespace{
+
+using Buffer = std::vector<uint64_t, AlignedAllocator<uint64_t>>;
+using View = DelaunayView<Float, Int>;
+
+// A snapshot of uniform points after some edits, so that removed vertices
+// and reordered triangles are saved too
+Delaunay<Float, Int> edited(const size_t n)
+{
+    Delaunay<Float, Int> d;
+    d.triangulate(uniform_points(n, 22));
+    d.remove(3);
+    d.move(5, {0.5, 0.25});
+    return d;
+}
+
+std::string save(const Delaunay<Float, Int>& d, const bool checksum)
+{
+    std::stringstream ss;
+    d.save(ss, checksum);
+    return ss.str();
+}
+
+// Copy of a snapshot on a 64 byte boundary, for DelaunayView to use in place
+Buffer aligned(const std::string& data)
+{
+    Buffer res(data.size()/sizeof(uint64_t));
+    std::memcpy(res.data(), data.data(), data.size());
+    return res;
+}
+
+SnapshotHeader header(const std::string& data)
+{
+    return View::header(std::as_bytes(std::span(data)));
+}
+
+void load(Delaunay<Float, Int>& d, const std::string& data)
+{
+    std::stringstream ss(data);
+    d.load(ss);
+}
+
+// Overwrite index i of triangle t in a snapshot, its three corners being
+// followed by its three neighbors
+std::string with_index(std::string data, const size_t t, const size_t i, const Int value)
+{
+    std::memcpy(data.data() + header(data).triangles_offset + t*sizeof(Triangle<Int>) + i*sizeof(Int), &value, sizeof(value));
+    return data;
+}
+
+Triangle<Int> triangle(const std::string& data, const size_t t)
+{
+    Triangle<Int> res;
+    std::memcpy(&res, data.data() + header(data).triangles_offset + t*sizeof(Triangle<Int>), sizeof(res));
+    return res;
+}
+
+}
+
+TEST(Snapshot, RoundTrip)
+{
+    const auto d = edited(1000);
+    for(const bool checksum : {false, true}){
+        const auto data = save(d, checksum);
+        EXPECT_EQ(data.size() % SnapshotHeader::alignment, 0);
+        Delaunay<Float, Int> e;
+        load(e, data);
+        EXPECT_EQ(e.vertices(), d.vertices());
+        EXPECT_EQ(e.triangle_count(), d.triangle_count());
+        const auto a = d.triangles(), b = e.triangles();
+        ASSERT_EQ(a.size(), b.size());
+        for(size_t t = 0; t < a.size(); t++){
+            EXPECT_EQ(a[t].vertices(), b[t].vertices()) << "triangle " << t;
+            EXPECT_EQ(a[t].neighbors(), b[t].neighbors()) << "triangle " << t;
+        }
+        // Used in place, and edited after loading
+        const auto buffer = aligned(data);
+        const View v(std::as_bytes(std::span(buffer)), true);
+        v.validate();
+        expect_delaunay(v);
+        EXPECT_EQ(triangle_set(v.triangles_view()), triangle_set(d.triangles_view()));
+        EXPECT_FALSE(e.remove(3));
+        e.insert(uniform_points(100, 23));
+        expect_delaunay(e);
+    }
+}
+
+TEST(Snapshot, CorruptedByteFailsChecksum)
+{
+    const auto d = edited(1000);
+    for(const bool checksum : {false, true}){
+        // A coordinate, which no index check can catch
+        auto data = save(d, checksum);
+        data[header(data).x_offset + 100] ^= 1;
+        Delaunay<Float, Int> e;
+        if(checksum){
+            EXPECT_THROW(load(e, data), std::invalid_argument);
+            const auto buffer = aligned(data);
+            EXPECT_THROW(View(std::as_bytes(std::span(buffer)), true), std::invalid_argument);
+        }else{
+            EXPECT_NO_THROW(load(e, data));
+        }
+    }
+}
+
+TEST(Snapshot, BadIndicesFailValidation)
+{
+    const auto d = edited(1000);
+    const auto data = save(d, false);
+    const auto h = header(data);
+    // The link between triangle 10 and a finite neighbor u, cut on both
+    // sides, and the neighbors of triangle 10 rotated so that every link is
+    // still mutual but crosses the wrong edge
+    const auto t = triangle(data, 10);
+    const Int k = static_cast<Int>(std::ranges::find_if(t.neighbors(), [&](const auto& n) {return *n < h.finite;}) - std::begin(t.neighbors()));
+    const Int u = *t.neighbors()[k];
+    const auto back = std::ranges::find(triangle(data, u).neighbors(), 10) - std::begin(triangle(data, u).neighbors());
+    const auto cut = with_index(with_index(data, 10, 3 + k, OptionalIndex<Int>::none), u, 3 + static_cast<size_t>(back), OptionalIndex<Int>::none);
+    const auto rotated = with_index(with_index(with_index(data, 10, 3, *t.neighbors()[1]), 10, 4, *t.neighbors()[2]), 10, 5, *t.neighbors()[0]);
+    // A corner out of range, a finite triangle with a corner at infinity, a
+    // neighbor out of range, a triangle linked to itself, a missing neighbor
+    // and neighbors across the wrong edges
+    const std::array bad{
+        with_index(data, 10, 0, static_cast<Int>(h.vertices + 5)),
+        with_index(data, 10, 1, View::infinite_vertex),
+        with_index(data, 10, 3, static_cast<Int>(h.triangles)),
+        with_index(data, 10, 4, 10),
+        cut,
+        rotated,
+    };
+    for(const auto& b : bad){
+        Delaunay<Float, Int> e;
+        EXPECT_THROW(load(e, b), std::invalid_argument);
+        const auto buffer = aligned(b);
+        const View v(std::as_bytes(std::span(buffer)), true);
+        EXPECT_THROW(v.validate(), std::invalid_argument);
+    }
+    // A neighbor not linked back, over arrays rather than a snapshot
+    const auto slots = d.view().triangle_slots();
+    std::vector<Triangle<Int>> triangles(std::begin(slots), std::end(slots));
+    triangles[0].neighbors()[0] = 1;
+    triangles[1].neighbors()[0] = 2;
+    const View v(d.coordinates(0), d.coordinates(1), triangles, static_cast<Int>(d.triangle_count()));
+    EXPECT_THROW(v.validate(), std::invalid_argument);
+    Delaunay<Float, Int> e;
+    EXPECT_THROW(e.assign(v), std::invalid_argument);
+}
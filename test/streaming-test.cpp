@@ -0,0 +1,96 @@
+#include "delaunay-streaming.h"
+#include "test-helpers.h"
+
+namespace{
+
+// Uniform points in the unit square, ordered cell by cell in row order on
+// a side x side grid, so that streaming them in that order numbers them as
+// they are in the vector
+std::vector<Vertex<Float>> points_by_cell(const size_t n, const size_t side, const uint64_t seed)
+{
+    auto res = uniform_points(n, seed);
+    auto cell = [side](const Vertex<Float>& p)
+        {
+            auto index = [side](const Float c) {return std::min(static_cast<size_t>(c*static_cast<Float>(side)), side - 1);};
+            return index(p.y())*side + index(p.x());
+        };
+    std::ranges::stable_sort(res, {}, cell);
+    return res;
+}
+
+}
+
+TEST(StreamingDelaunay, MatchesTriangulateCellByCell)
+{
+    const size_t side = 10;
+    const auto points = points_by_cell(5000, side, 23);
+    const Grid<Float> grid{0, 0, 1./side, 1./side, side, side};
+    std::vector<Triangle<Int>> emitted;
+    StreamingDelaunay<Float, Int> s(grid, [&](const Triangle<Int>& t, const Triangle<Float>& c)
+        {
+            for(Int k = 0; k < 3; k++){
+                EXPECT_EQ(c.vertices()[k], points[t.vertices()[k]]);
+            }
+            emitted.push_back(t);
+        });
+    size_t begin = 0;
+    for(size_t j = 0; j < side; j++){
+        for(size_t i = 0; i < side; i++){
+            size_t end = begin;
+            while(end < points.size() && s.cell(points[end]) == std::array{i, j}){
+                end++;
+            }
+            const auto indices = s.insert(std::span(points).subspan(begin, end - begin));
+            for(size_t k = 0; k < indices.size(); k++){
+                ASSERT_EQ(indices[k], begin + k);
+            }
+            s.finalize(i, j);
+            begin = end;
+        }
+    }
+    ASSERT_EQ(begin, points.size());
+    s.finish();
+
+    EXPECT_EQ(s.active_triangles(), 0);
+    EXPECT_EQ(s.active_vertices(), 0);
+    EXPECT_EQ(s.emitted(), emitted.size());
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    EXPECT_EQ(triangle_set(emitted), triangle_set(d.triangles_view()));
+}
+
+TEST(StreamingDelaunay, RejectsPointsInFinalizedCells)
+{
+    StreamingDelaunay<Float, Int> s(Grid<Float>{0, 0, 1, 1, 2, 2}, [](const Triangle<Int>&, const Triangle<Float>&) {});
+    s.insert(Vertex<Float>{1.5, 0.5});
+    s.finalize(0, 0);
+    EXPECT_THROW(s.insert(Vertex<Float>{0.5, 0.5}), std::logic_error);
+    const std::vector<Vertex<Float>> chunk{{1.5, 1.5}, {0.25, 0.75}};
+    EXPECT_THROW(s.insert(chunk), std::logic_error);
+    EXPECT_THROW(s.insert(Vertex<Float>{3, 0.5}), std::out_of_range);
+    // A rejected chunk reads none of its points
+    EXPECT_EQ(s.size(), 1);
+    EXPECT_EQ(s.insert(Vertex<Float>{1.5, 0.5}), 0);
+}
+
+TEST(StreamingDelaunay, CollinearPointsInFinalizedCells)
+{
+    // Collinear points wait for a point off their line, and are only
+    // triangulated after their cell is finalized
+    std::vector<Triangle<Int>> emitted;
+    StreamingDelaunay<Float, Int> s(Grid<Float>{0, 0, 1, 1, 2, 1}, [&](const Triangle<Int>& t, const Triangle<Float>&)
+        {
+            emitted.push_back(t);
+        });
+    const std::vector<Vertex<Float>> points{{0.1, 0.1}, {0.2, 0.2}, {0.3, 0.3}, {1.5, 0.2}};
+    s.insert(std::span(points).first(3));
+    s.finalize(0, 0);
+    s.insert(points[3]);
+    s.finish();
+
+    EXPECT_EQ(s.active_triangles(), 0);
+    EXPECT_EQ(s.active_vertices(), 0);
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    EXPECT_EQ(triangle_set(emitted), triangle_set(d.triangles_view()));
+}
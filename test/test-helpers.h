@@ -0,0 +1,78 @@
+#ifndef DELAUNAY_TEST_HELPERS_H
+#define DELAUNAY_TEST_HELPERS_H
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "delaunay-triangulation.h"
+
+using Float = double;
+using Int = uint32_t;
+
+inline std::vector<Vertex<Float>> uniform_points(const size_t n, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<Float> unit(0, 1);
+    std::vector<Vertex<Float>> res(n);
+    for(auto& p : res){
+        p = {unit(rng), unit(rng)};
+    }
+    return res;
+}
+
+// Integer points on a side x side grid, where every unit square has four
+// cocircular corners
+inline std::vector<Vertex<Float>> grid_points(const size_t side)
+{
+    std::vector<Vertex<Float>> res;
+    for(size_t j = 0; j < side; j++){
+        for(size_t i = 0; i < side; i++){
+            res.push_back({static_cast<Float>(i), static_cast<Float>(j)});
+        }
+    }
+    return res;
+}
+
+// Checks that the finite triangles are counterclockwise, that neighbor
+// links between them are mutual, and that no vertex across an edge lies
+// inside a circumcircle. The last is local, but a triangulation that is
+// locally Delaunay at every edge has empty circumcircles.
+template<class Triangulation>
+void expect_delaunay(const Triangulation& d)
+{
+    const auto triangles = d.triangles_view();
+    const auto x = d.coordinates(0), y = d.coordinates(1);
+    for(Int t = 0; t < triangles.size(); t++){
+        const auto& vs = triangles[t].vertices();
+        ASSERT_GT(orient2d(x[vs[0]], y[vs[0]], x[vs[1]], y[vs[1]], x[vs[2]], y[vs[2]]), 0) << "triangle " << t;
+        for(Int k = 0; k < 3; k++){
+            const auto n = triangles[t].neighbors()[k];
+            ASSERT_TRUE(n) << "triangle " << t;
+            if(*n >= triangles.size()){
+                continue;
+            }
+            const auto& ns = triangles[*n].neighbors();
+            ASSERT_NE(std::ranges::find(ns, t), std::end(ns)) << "triangle " << t << " and " << *n;
+            for(const Int w : triangles[*n]){
+                EXPECT_LE(incircle(x[vs[0]], y[vs[0]], x[vs[1]], y[vs[1]], x[vs[2]], y[vs[2]], x[w], y[w]), 0)
+                    << "vertex " << w << " inside the circumcircle of triangle " << t;
+            }
+        }
+    }
+}
+
+// The finite triangles as sorted vertex triples, sorted, for comparing
+// triangulations regardless of slot order and rotation
+inline std::vector<std::array<Int, 3>> triangle_set(std::span<const Triangle<Int>> triangles)
+{
+    std::vector<std::array<Int, 3>> res;
+    for(const auto& t : triangles){
+        std::array<Int, 3> vs = t.vertices();
+        std::ranges::sort(vs);
+        res.push_back(vs);
+    }
+    std::ranges::sort(res);
+    return res;
+}
+
+#endif // DELAUNAY_TEST_HELPERS_H
@@ -0,0 +1,152 @@
+#include <numbers>
+#include "delaunay-tetrahedralization.h"
+#include "test-helpers.h"
+
+namespace{
+
+using Point = Vertex<Float, 3>;
+
+std::vector<Point> uniform_points_3d(const size_t n, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<Float> unit(0, 1);
+    std::vector<Point> res(n);
+    for(auto& p : res){
+        p = {unit(rng), unit(rng), unit(rng)};
+    }
+    return res;
+}
+
+// Integer points on a side^3 lattice, shuffled and with every tenth point
+// repeated. Every lattice cube has eight cospherical corners and every face
+// of the hull is a plane of coplanar points.
+std::vector<Point> lattice_points(const size_t side, const uint64_t seed)
+{
+    std::vector<Point> res;
+    for(size_t k = 0; k < side; k++){
+        for(size_t j = 0; j < side; j++){
+            for(size_t i = 0; i < side; i++){
+                res.push_back({static_cast<Float>(i), static_cast<Float>(j), static_cast<Float>(k)});
+            }
+        }
+    }
+    for(size_t i = 0; i < side*side*side; i += 10){
+        res.push_back(res[i]);
+    }
+    std::mt19937_64 rng(seed);
+    std::ranges::shuffle(res, rng);
+    return res;
+}
+
+// Points on the unit sphere, all of them nearly cospherical
+std::vector<Point> sphere_points(const size_t n, const uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<Float> height(-1, 1), angle(0, 2*std::numbers::pi_v<Float>);
+    std::vector<Point> res(n);
+    for(auto& p : res){
+        const Float z = height(rng), phi = angle(rng), r = std::sqrt(1 - z*z);
+        p = {r*std::cos(phi), r*std::sin(phi), z};
+    }
+    return res;
+}
+
+Float orientation(const std::vector<Point>& v, const std::array<Int, 4>& t)
+{
+    const auto &a = v[t[0]], &b = v[t[1]], &c = v[t[2]], &d = v[t[3]];
+    return orient3d(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(), c.z(), d.x(), d.y(), d.z());
+}
+
+// Checks that every tetrahedron is positively oriented, that links between
+// finite tetrahedra are mutual, and that no vertex lies inside a
+// circumsphere, the last against every vertex rather than only across faces.
+// Returns six times the summed volume of the tetrahedra, which is exact for
+// integer coordinates.
+Float expect_delaunay_3d(const Tetrahedralization<Float, Int>& d)
+{
+    const auto v = d.vertices();
+    const auto tetrahedra = d.tetrahedra_view();
+    const auto neighbors = d.neighbors_view();
+    const Int m = static_cast<Int>(tetrahedra.size());
+    Float volume = 0;
+    for(Int t = 0; t < m; t++){
+        const auto& vs = tetrahedra[t];
+        const Float o = orientation(v, vs);
+        EXPECT_GT(o, 0) << "tetrahedron " << t;
+        volume += o;
+        for(Int j = 0; j < 4; j++){
+            const Int l = neighbors[t][j];
+            if(l/4 < m){
+                EXPECT_EQ(neighbors[l/4][l%4], 4*t + j) << "tetrahedron " << t << " face " << j;
+                EXPECT_EQ(d.neighbor(t, j), l/4) << "tetrahedron " << t << " face " << j;
+            }else{
+                EXPECT_FALSE(d.neighbor(t, j)) << "tetrahedron " << t << " face " << j;
+            }
+        }
+        const auto &a = v[vs[0]], &b = v[vs[1]], &c = v[vs[2]], &e = v[vs[3]];
+        for(Int w = 0; w < v.size(); w++){
+            const auto& p = v[w];
+            EXPECT_LE(insphere(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(), c.z(),
+                               e.x(), e.y(), e.z(), p.x(), p.y(), p.z()), 0)
+                << "vertex " << w << " inside the circumsphere of tetrahedron " << t;
+        }
+    }
+    return volume;
+}
+
+}
+
+TEST(Tetrahedralization, UniformPoints)
+{
+    Tetrahedralization<Float, Int> d;
+    d.tetrahedralize(uniform_points_3d(300, 15));
+    EXPECT_GT(d.tetrahedron_count(), 0);
+    expect_delaunay_3d(d);
+}
+
+TEST(Tetrahedralization, LatticeWithDuplicates)
+{
+    // The tetrahedra exactly tile the box, missing no lattice cube
+    const size_t side = 5;
+    Tetrahedralization<Float, Int> d;
+    d.tetrahedralize(lattice_points(side, 1));
+    const Float edge = side - 1;
+    EXPECT_EQ(expect_delaunay_3d(d), 6*edge*edge*edge);
+}
+
+TEST(Tetrahedralization, SphereSurface)
+{
+    const auto points = sphere_points(80, 2);
+    Tetrahedralization<Float, Int> d;
+    d.tetrahedralize(points);
+    EXPECT_GT(d.tetrahedron_count(), 0);
+    expect_delaunay_3d(d);
+    // Interleaved coordinates give the same tetrahedra
+    std::vector<Float> coordinates;
+    for(const auto& p : points){
+        coordinates.insert(std::end(coordinates), {p.x(), p.y(), p.z()});
+    }
+    Tetrahedralization<Float, Int> e;
+    e.tetrahedralize(coordinates);
+    EXPECT_EQ(e.tetrahedra(), d.tetrahedra());
+    for(const size_t stride : {0, 1, 2}){
+        EXPECT_THROW(e.tetrahedralize(coordinates, stride), std::invalid_argument) << "stride " << stride;
+    }
+}
+
+TEST(Tetrahedralization, DegenerateInputsHaveNoTetrahedra)
+{
+    Tetrahedralization<Float, Int> d;
+    d.tetrahedralize(std::vector<Point>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}});
+    EXPECT_EQ(d.tetrahedron_count(), 0);
+    EXPECT_TRUE(d.tetrahedra().empty());
+    // Coplanar points, on a tilted plane so that no coordinate is constant.
+    // Integer coordinates keep them exactly in the plane.
+    std::vector<Point> points;
+    for(const auto& p : grid_points(10)){
+        points.push_back({p.x(), p.y(), p.x() + 2*p.y()});
+    }
+    d.tetrahedralize(points);
+    EXPECT_EQ(d.tetrahedron_count(), 0);
+    EXPECT_TRUE(d.neighbors_view().empty());
+}
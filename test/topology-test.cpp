@@ -0,0 +1,127 @@
+#include <set>
+#include "test-helpers.h"
+
+namespace{
+
+Delaunay<Float, Int> edited(const std::vector<Vertex<Float>>& points)
+{
+    Delaunay<Float, Int> d;
+    d.triangulate(points);
+    for(Int v = 0; v < points.size(); v += 7){
+        d.remove(v);
+    }
+    return d;
+}
+
+// Whether a and b follow each other counterclockwise in triangle t
+bool has_edge(const Triangle<Int>& t, const Int a, const Int b)
+{
+    const auto& vs = t.vertices();
+    for(Int k = 0; k < 3; k++){
+        if(vs[k] == a && vs[(k + 1) % 3] == b){
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+TEST(Topology, HalfEdgeRoundTrip)
+{
+    for(const auto& points : {uniform_points(500, 14), grid_points(15)}){
+        const auto d = edited(points);
+        const auto mesh = d.half_edges();
+        ASSERT_EQ(mesh.faces(), d.view().triangle_slots().size());
+        for(Int h = 0; h < mesh.size(); h++){
+            ASSERT_NE(mesh.twin(h), mesh.none) << "half-edge " << h;
+            EXPECT_EQ(mesh.twin(mesh.twin(h)), h) << "half-edge " << h;
+            EXPECT_EQ(mesh.org(mesh.twin(h)), mesh.dest(h)) << "half-edge " << h;
+        }
+        auto e = d;
+        e.assign_half_edges(mesh);
+        const auto a = d.view().triangle_slots(), b = e.view().triangle_slots();
+        ASSERT_EQ(a.size(), b.size());
+        for(size_t t = 0; t < a.size(); t++){
+            EXPECT_EQ(a[t].vertices(), b[t].vertices()) << "triangle " << t;
+            EXPECT_EQ(a[t].neighbors(), b[t].neighbors()) << "triangle " << t;
+        }
+        EXPECT_EQ(e.triangle_count(), d.triangle_count());
+        EXPECT_EQ(e.half_edges().triangles(), mesh.triangles());
+        expect_delaunay(e);
+    }
+}
+
+TEST(Topology, HalfEdgesOverOtherVerticesThrow)
+{
+    Delaunay<Float, Int> d, e;
+    d.triangulate(uniform_points(100, 15));
+    e.triangulate(uniform_points(101, 15));
+    EXPECT_THROW(e.assign_half_edges(d.half_edges()), std::invalid_argument);
+}
+
+TEST(Topology, EdgesAndAdjacency)
+{
+    for(const auto& points : {uniform_points(500, 16), grid_points(15)}){
+        auto d = edited(points);
+        const auto triangles = d.triangles_view();
+        const auto edges = d.edges_view();
+        EXPECT_EQ(d.edges().size(), edges.size());
+        std::set<std::pair<Int, Int>> seen;
+        size_t hull = 0;
+        for(const auto& e : edges){
+            const auto [a, b] = e.vertices();
+            EXPECT_TRUE(seen.insert(std::minmax(a, b)).second) << "edge " << e;
+            const auto [left, right] = e.neighbors();
+            ASSERT_TRUE(left) << "edge " << e;
+            ASSERT_LT(*left, triangles.size()) << "edge " << e;
+            EXPECT_TRUE(has_edge(triangles[*left], a, b)) << "edge " << e;
+            if(right){
+                ASSERT_LT(*right, triangles.size()) << "edge " << e;
+                EXPECT_TRUE(has_edge(triangles[*right], b, a)) << "edge " << e;
+            }else{
+                hull++;
+            }
+        }
+        // Every triangle has three edges, each shared but for the hull edges
+        EXPECT_EQ(3*triangles.size(), 2*edges.size() - hull);
+
+        const auto& adj = d.adjacency();
+        ASSERT_EQ(adj.size(), points.size());
+        EXPECT_EQ(adj.vertices().size(), 2*edges.size());
+        EXPECT_EQ(adj.triangles().size(), 3*triangles.size());
+        for(Int v = 0; v < adj.size(); v++){
+            for(const Int w : adj.vertices(v)){
+                EXPECT_TRUE(seen.contains(std::minmax(v, w))) << "vertex " << v << " and " << w;
+            }
+            for(const Int t : adj.triangles(v)){
+                EXPECT_NE(std::ranges::find(triangles[t], v), std::end(triangles[t])) << "vertex " << v << " triangle " << t;
+            }
+        }
+        for(Int v = 0; v < points.size(); v += 7){
+            EXPECT_TRUE(adj.vertices(v).empty()) << "removed vertex " << v;
+        }
+    }
+}
+
+TEST(Topology, IndexBuffer)
+{
+    const auto d = edited(uniform_points(500, 17));
+    std::vector<uint32_t> flat;
+    for(const auto& t : d.triangles_view()){
+        flat.insert(std::end(flat), std::begin(t), std::end(t));
+    }
+    ASSERT_EQ(flat.size(), 3*d.triangle_count());
+    EXPECT_EQ(d.index_buffer(), flat);
+    // A longer buffer is written at its start only
+    std::vector<uint32_t> out(flat.size() + 5, 7);
+    EXPECT_EQ(d.index_buffer(out), flat.size());
+    EXPECT_TRUE(std::equal(std::begin(flat), std::end(flat), std::begin(out)));
+    EXPECT_TRUE(std::all_of(std::begin(out) + flat.size(), std::end(out), [](const uint32_t i) {return i == 7;}));
+    EXPECT_THROW(d.index_buffer(std::span(out).first(flat.size() - 1)), std::length_error);
+    // Without triangles nothing is written
+    Delaunay<Float, Int> empty;
+    empty.triangulate(std::vector<Vertex<Float>>{{0, 0}, {1, 1}});
+    EXPECT_TRUE(empty.index_buffer().empty());
+    EXPECT_EQ(empty.index_buffer(std::span<uint32_t>()), 0);
+}
@@ -0,0 +1,116 @@
+#include <numeric>
+#include "test-helpers.h"
+
+namespace{
+
+using Diagram = VoronoiDiagram<Float, Int>;
+
+Float cell_area(const Diagram& vd, const size_t v)
+{
+    const auto cell = vd.cell(v);
+    Float res = 0;
+    for(size_t i = 0; i < cell.size(); i++){
+        const auto a = vd.vertex(cell[i]), b = vd.vertex(cell[(i + 1) % cell.size()]);
+        res += a.x()*b.y() - b.x()*a.y();
+    }
+    return res/2;
+}
+
+std::vector<Float> cell_areas(const Diagram& vd)
+{
+    std::vector<Float> res(vd.size());
+    for(size_t v = 0; v < res.size(); v++){
+        res[v] = cell_area(vd, v);
+    }
+    return res;
+}
+
+// Checks that the cells of the diagram clipped to the box from lo to hi
+// tile the box, and that they match those of a fresh triangulation with the
+// same triangles, whose diagram has never been cached
+void expect_cells(Delaunay<Float, Int>& d, const Vertex<Float>& lo, const Vertex<Float>& hi)
+{
+    const auto areas = cell_areas(d.voronoi(lo, hi));
+    ASSERT_EQ(areas.size(), d.coordinates(0).size());
+    const Float box = (hi.x() - lo.x())*(hi.y() - lo.y());
+    EXPECT_NEAR(std::accumulate(std::begin(areas), std::end(areas), Float(0)), box, 1e-9*box);
+    for(const Float a : areas){
+        EXPECT_GE(a, 0);
+    }
+    Delaunay<Float, Int> fresh;
+    fresh.assign(d.view());
+    const auto expected = cell_areas(fresh.voronoi(lo, hi));
+    for(size_t v = 0; v < areas.size(); v++){
+        EXPECT_NEAR(areas[v], expected[v], 1e-9*box) << "cell " << v;
+    }
+}
+
+}
+
+TEST(Voronoi, CellsTileTheBox)
+{
+    Delaunay<Float, Int> d;
+    d.triangulate(uniform_points(500, 20));
+    expect_cells(d, {-0.5, -0.5}, {1.5, 1.5});
+    // A box cutting through the cells, and one inside the points
+    expect_cells(d, {0.1, -0.2}, {0.7, 1.1});
+    expect_cells(d, {0.3, 0.3}, {0.6, 0.6});
+    // The default box is the bounding box grown on every side by half its
+    // larger side, or by at least one
+    const auto& vd = d.voronoi();
+    const auto areas = cell_areas(vd);
+    const Float sum = std::accumulate(std::begin(areas), std::end(areas), Float(0));
+    const auto [xmin, xmax] = std::ranges::minmax(d.coordinates(0));
+    const auto [ymin, ymax] = std::ranges::minmax(d.coordinates(1));
+    const Float margin = std::max<Float>(std::max(xmax - xmin, ymax - ymin)/2, 1);
+    EXPECT_NEAR(sum, (xmax - xmin + 2*margin)*(ymax - ymin + 2*margin), 1e-9);
+}
+
+TEST(Voronoi, CellsFollowEdits)
+{
+    // Each edit changes only some triangles, whose circumcenters are
+    // recomputed while the others are kept
+    const Vertex<Float> lo{-0.5, -0.5}, hi{1.5, 1.5};
+    Delaunay<Float, Int> d;
+    d.triangulate(uniform_points(500, 21));
+    expect_cells(d, lo, hi);
+    std::mt19937_64 rng(22);
+    std::uniform_real_distribution<Float> unit(0, 1);
+    for(Int v = 0; v < 20; v++){
+        ASSERT_TRUE(d.remove(3*v));
+        expect_cells(d, lo, hi);
+        EXPECT_TRUE(d.voronoi(lo, hi).cell(3*v).empty());
+        d.move(3*v + 1, {unit(rng), unit(rng)});
+        expect_cells(d, lo, hi);
+    }
+    // Many changes at once, recomputing every circumcenter
+    for(Int v = 100; v < 400; v++){
+        d.move(v, {unit(rng), unit(rng)});
+    }
+    expect_cells(d, lo, hi);
+    // Cells cut by a box, whose clipping vertices are kept for the cells the
+    // edits leave alone, and new vertices
+    const Vertex<Float> inner_lo{0.2, 0.3}, inner_hi{0.7, 0.8};
+    expect_cells(d, inner_lo, inner_hi);
+    for(Int v = 400; v < 420; v++){
+        ASSERT_TRUE(d.remove(v));
+        expect_cells(d, inner_lo, inner_hi);
+        d.move(v + 20, {unit(rng), unit(rng)});
+        expect_cells(d, inner_lo, inner_hi);
+        const Vertex<Float> p{unit(rng), unit(rng)};
+        d.insert(std::span(&p, 1));
+        expect_cells(d, inner_lo, inner_hi);
+    }
+}
+
+TEST(Voronoi, CocircularPoints)
+{
+    // Four triangles meet at a circumcenter in every grid square
+    Delaunay<Float, Int> d;
+    d.triangulate(grid_points(12));
+    expect_cells(d, {-3, -3}, {14, 14});
+    for(Int v = 0; v < 144; v += 13){
+        d.remove(v);
+    }
+    expect_cells(d, {-3, -3}, {14, 14});
+}